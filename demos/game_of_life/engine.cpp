@@ -0,0 +1,46 @@
+#include "engine.hpp"
+
+#include <cstdint>
+#include <limits>
+#include <set>
+#include <vector>
+
+#include "coordinate.hpp"
+
+namespace gol {
+
+void Engine::for_each_alive(const Visitor& visit) const {
+    const auto min = std::numeric_limits<int>::min();
+    const auto max = std::numeric_limits<int>::max();
+    this->for_each_alive_in({min, min}, {max, max}, visit);
+}
+
+void Engine::import(const std::vector<Coordinate>& cells) {
+    this->import([&cells](const Run_visitor& visit) {
+        for (Coordinate cell : cells) {
+            visit({cell, 1});
+        }
+    });
+}
+
+void Engine::reset_generation_count() {
+    generation_count_ = 0;
+    generation_count_changed(generation_count_);
+}
+
+void Engine::increment_generation_count(std::uint64_t count) {
+    generation_count_ += count;
+    generation_count_changed(generation_count_);
+}
+
+std::uint16_t Engine::to_mask(const std::set<int>& counts) {
+    std::uint16_t mask{0};
+    for (int n : counts) {
+        if (n >= 0 && n <= 8) {
+            mask |= 1 << n;
+        }
+    }
+    return mask;
+}
+
+}  // namespace gol
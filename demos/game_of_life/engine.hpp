@@ -0,0 +1,147 @@
+#ifndef CPPURSES_DEMOS_GAME_OF_LIFE_ENGINE_HPP
+#define CPPURSES_DEMOS_GAME_OF_LIFE_ENGINE_HPP
+#include <cstdint>
+#include <functional>
+#include <iterator>
+#include <set>
+#include <vector>
+
+#include <signals/signal.hpp>
+
+#include "cell.hpp"
+#include "coordinate.hpp"
+
+namespace gol {
+
+/// Interface for the game state, updates a pattern to its next generation.
+/** Rules and the generation count are shared by every implementation. */
+class Engine {
+   public:
+    /// Called with the position and age of a living cell.
+    using Visitor = std::function<void(Coordinate, Cell::Age_t)>;
+
+    /// Called with the position of a cell that died.
+    using Death_visitor = std::function<void(Coordinate)>;
+
+    /// A row of \p length living cells, from \p position to the right.
+    struct Run {
+        Coordinate position;
+        int length;
+    };
+
+    /// Called with each Run of living cells in a pattern.
+    using Run_visitor = std::function<void(Run)>;
+
+    /// Calls its argument with each Run of a pattern, in any order.
+    using Run_source = std::function<void(const Run_visitor&)>;
+
+    virtual ~Engine() = default;
+
+    /// Updates the engine state to the next generation of cells.
+    virtual void get_next_generation() = 0;
+
+    /// Start computing the next generation in the background, if supported.
+    /** The current generation can be read while it is computed, the next call
+     *  to get_next_generation() completes it. Editing cells throws it away. */
+    virtual void prepare_next_generation() {}
+
+    /// Advance 2^exponent generations per get_next_generation(), if supported.
+    /** Engines that only step one generation at a time ignore this. */
+    virtual void set_step_exponent(int /* exponent */) {}
+
+    /// Create a living cell at \p position and reset the generation count.
+    /** No-op if already alive at \p position. */
+    virtual void give_life(Coordinate position) = 0;
+
+    /// Kill cell at \p position and reset the generation count.
+    /** No-op if no cell alive at \p position. */
+    virtual void kill(Coordinate position) = 0;
+
+    /// Remove all living cells from the pattern and reset the generation count.
+    virtual void kill_all() = 0;
+
+    /// Check if a cell is alive at the given Coordinate.
+    virtual bool alive_at(Coordinate position) const = 0;
+
+    /// Add the living cells of each Run of \p source, reset the generation count.
+    /** Patterns are loaded straight from a parser, without collecting the
+     *  cells first, see get_rle.hpp. */
+    virtual void import(const Run_source& source) = 0;
+
+    /// Add a living cell at each of \p cells, reset the generation count.
+    void import(const std::vector<Coordinate>& cells);
+
+    /// Call \p visit for each living cell within [top_left, bottom_right].
+    /** Both corners are inclusive. Cells are not visited in any given order. */
+    virtual void for_each_alive_in(Coordinate top_left,
+                                   Coordinate bottom_right,
+                                   const Visitor& visit) const = 0;
+
+    /// Visit each cell within [top_left, bottom_right] the last step changed.
+    /** \p changed is called for each cell that was born or aged, \p died for
+     *  each cell that died. Return false, and visit nothing, if the changes
+     *  are not known, as after an edit, or if not supported. */
+    virtual bool for_each_change_in(Coordinate /* top_left */,
+                                    Coordinate /* bottom_right */,
+                                    const Visitor& /* changed */,
+                                    const Death_visitor& /* died */) const {
+        return false;
+    }
+
+    /// Call \p visit for each living cell.
+    void for_each_alive(const Visitor& visit) const;
+
+    /// Set the neighbor counts that allow survival for a living cell.
+    template <typename Container_t>
+    void set_survival_rule(const Container_t& neighbor_counts) {
+        survival_rule_ = {std::begin(neighbor_counts),
+                          std::end(neighbor_counts)};
+        if (survival_rule_.empty()) {
+            survival_rule_.insert(9);
+        }
+    }
+
+    /// Set the neighbor counts that allow new cells to form from dead cells.
+    template <typename Container_t>
+    void set_birth_rule(const Container_t& neighbor_counts) {
+        birth_rule_ = {std::begin(neighbor_counts), std::end(neighbor_counts)};
+    }
+
+    /// Return the neighbor counts that allow new cells to form.
+    const std::set<int>& birth_rule() const { return birth_rule_; }
+
+    /// Return the neighbor counts that allow a living cell to survive.
+    const std::set<int>& survival_rule() const { return survival_rule_; }
+
+    /// Return the number of generations since the pattern was last edited.
+    std::uint64_t generation_count() const { return generation_count_; }
+
+    sig::Signal<void(std::uint64_t)> generation_count_changed;
+
+   protected:
+    Engine() = default;
+
+    std::set<int> birth_rule_{3};
+    std::set<int> survival_rule_{2, 3};
+
+    /// Return the birth rule as a mask, bit n is set if n neighbors give birth.
+    std::uint16_t birth_mask() const { return to_mask(birth_rule_); }
+
+    /// Return the survival rule as a mask, bit n is set if n neighbors survive.
+    std::uint16_t survival_mask() const { return to_mask(survival_rule_); }
+
+    /// Set the generation count to 0 and emit generation_count_changed.
+    void reset_generation_count();
+
+    /// Add \p count to the generation count and emit generation_count_changed.
+    void increment_generation_count(std::uint64_t count = 1);
+
+   private:
+    std::uint64_t generation_count_{0};
+
+    /// Return the neighbor counts in [0, 8] of \p counts as a mask.
+    static std::uint16_t to_mask(const std::set<int>& counts);
+};
+
+}  // namespace gol
+#endif  // CPPURSES_DEMOS_GAME_OF_LIFE_ENGINE_HPP
@@ -1,52 +1,213 @@
 #include "exporters.hpp"
 
+#include <algorithm>
+#include <cstddef>
 #include <fstream>
+#include <limits>
+#include <set>
 #include <string>
+#include <vector>
 
-#include "game_of_life_engine.hpp"
+#include "coordinate.hpp"
+#include "engine.hpp"
+
+namespace {
+using namespace gol;
+
+/// Smallest rectangle containing every living cell.
+struct Bounds {
+    Coordinate top_left;
+    Coordinate bottom_right;
+
+    bool empty() const { return top_left.x > bottom_right.x; }
+    int width() const { return bottom_right.x - top_left.x + 1; }
+    int height() const { return bottom_right.y - top_left.y + 1; }
+};
+
+Bounds bounds_of(const Engine& engine) {
+    const int min = std::numeric_limits<int>::min();
+    const int max = std::numeric_limits<int>::max();
+    Bounds bounds{{max, max}, {min, min}};
+    engine.for_each_alive([&bounds](Coordinate position, Cell::Age_t) {
+        bounds.top_left.x = std::min(bounds.top_left.x, position.x);
+        bounds.top_left.y = std::min(bounds.top_left.y, position.y);
+        bounds.bottom_right.x = std::max(bounds.bottom_right.x, position.x);
+        bounds.bottom_right.y = std::max(bounds.bottom_right.y, position.y);
+    });
+    return bounds;
+}
+
+/// Call \p visit(y, runs) for each row with living cells, from the top down.
+/** Runs are ordered left to right. Rows are collected a band at a time, so
+ *  only a band of the pattern is held in memory while writing. */
+template <typename Function_t>
+void for_each_row(const Engine& engine,
+                  const Bounds& bounds,
+                  const Function_t& visit) {
+    const int band_height{64};
+    std::vector<std::vector<int>> band(band_height);
+    std::vector<Engine::Run> runs;
+    for (long long top{bounds.top_left.y}; top <= bounds.bottom_right.y;
+         top += band_height) {
+        const int first = static_cast<int>(top);
+        const int last = static_cast<int>(std::min<long long>(
+            bounds.bottom_right.y, top + band_height - 1));
+        engine.for_each_alive_in(
+            {bounds.top_left.x, first}, {bounds.bottom_right.x, last},
+            [&band, first](Coordinate position, Cell::Age_t) {
+                band[position.y - first].push_back(position.x);
+            });
+        for (int y{first}; y <= last; ++y) {
+            auto& xs = band[y - first];
+            if (xs.empty()) {
+                continue;
+            }
+            std::sort(std::begin(xs), std::end(xs));
+            runs.clear();
+            for (int x : xs) {
+                if (!runs.empty() &&
+                    runs.back().position.x + runs.back().length == x) {
+                    ++runs.back().length;
+                } else {
+                    runs.push_back({{x, y}, 1});
+                }
+            }
+            visit(y, runs);
+            xs.clear();
+        }
+    }
+}
+
+/// Write each row of \p engine as \p dead and \p alive characters.
+/** Rows without living cells are written as a single \p dead character. */
+void write_rows(std::ofstream& file,
+                const Engine& engine,
+                const Bounds& bounds,
+                char dead,
+                char alive) {
+    int next_y{bounds.top_left.y};
+    for_each_row(engine, bounds,
+                 [&](int y, const std::vector<Engine::Run>& runs) {
+                     for (; next_y < y; ++next_y) {
+                         file << dead << '\n';
+                     }
+                     int x{bounds.top_left.x};
+                     for (const Engine::Run& run : runs) {
+                         file << std::string(run.position.x - x, dead)
+                              << std::string(run.length, alive);
+                         x = run.position.x + run.length;
+                     }
+                     file << '\n';
+                     ++next_y;
+                 });
+}
+
+/// Return the neighbor counts of \p rule as a string of digits.
+std::string digits(const std::set<int>& rule) {
+    std::string result;
+    for (int n : rule) {
+        if (n >= 0 && n <= 8) {
+            result.push_back(static_cast<char>('0' + n));
+        }
+    }
+    return result;
+}
+
+/// Writes RLE items, breaking lines before they reach the maximum length.
+class RLE_writer {
+   public:
+    explicit RLE_writer(std::ofstream& file) : file_{file} {}
+
+    /// Write \p count of \p tag, the count is left out if it is one.
+    void write(int count, char tag) {
+        std::string item;
+        if (count > 1) {
+            item = std::to_string(count);
+        }
+        item.push_back(tag);
+        if (line_length_ + item.size() > max_line_length) {
+            file_ << '\n';
+            line_length_ = 0;
+        }
+        file_ << item;
+        line_length_ += item.size();
+    }
+
+   private:
+    static constexpr std::size_t max_line_length{70};
+    std::ofstream& file_;
+    std::size_t line_length_{0};
+};
+
+constexpr std::size_t RLE_writer::max_line_length;
+}  // namespace
 
 namespace gol {
 
-void export_as_life_1_05(const std::string& /* filename */,
-                         const Game_of_life_engine& /* engine */) {
-    // std::ofstream file{filename};
-    // file << "#Life 1.05\n";
-    // file << "#R 23/3\n";
-    // auto first = true;
-    // for (auto x = std::size_t{0}; x < engine.width(); ++x) {
-    //     for (auto y = std::size_t{0}; y < engine.height(); ++y) {
-    //         if (engine.is_alive_at({x, y})) {
-    //             if (first) {
-    //                 file << "#P " << x - static_cast<int>(engine.width()) / 2
-    //                      << ' ' << y - static_cast<int>(engine.height()) / 2
-    //                      << '\n';
-    //                 first = false;
-    //                 // file << std::string(x, '.');
-    //             }
-    //             file << '*';
-    //         } else {
-    //             if (!first) {
-    //                 file << '.';
-    //             }
-    //         }
-    //     }
-    //     file << '\n';
-    // }
-}
-
-void export_as_life_1_06(const std::string& filename,
-                         const Game_of_life_engine& engine) {
+void export_as_life_1_05(const std::string& filename, const Engine& engine) {
+    std::ofstream file{filename};
+    file << "#Life 1.05\n";
+    const std::string survival = digits(engine.survival_rule());
+    const std::string birth = digits(engine.birth_rule());
+    if (survival == "23" && birth == "3") {
+        file << "#N\n";
+    } else {
+        file << "#R " << survival << '/' << birth << '\n';
+    }
+    const Bounds bounds = bounds_of(engine);
+    if (bounds.empty()) {
+        return;
+    }
+    file << "#P " << bounds.top_left.x << ' ' << bounds.top_left.y << '\n';
+    write_rows(file, engine, bounds, '.', '*');
+}
+
+void export_as_life_1_06(const std::string& filename, const Engine& engine) {
     std::ofstream file{filename};
     file << "#Life 1.06\n";
-    for (const auto& coord_cell : engine) {
-        const Coordinate& coord = coord_cell.first;
-        file << coord.x << ' ' << coord.y << '\n';
+    engine.for_each_alive([&file](Coordinate position, Cell::Age_t) {
+        file << position.x << ' ' << position.y << '\n';
+    });
+}
+
+void export_as_plaintext(const std::string& filename, const Engine& engine) {
+    std::ofstream file{filename};
+    file << "!Name: " << filename << '\n';
+    const Bounds bounds = bounds_of(engine);
+    if (!bounds.empty()) {
+        write_rows(file, engine, bounds, '.', 'O');
     }
 }
 
-void export_as_plaintext(const std::string& /* filename */,
-                         const Game_of_life_engine& /* engine */) {}
+void export_as_rle(const std::string& filename, const Engine& engine) {
+    std::ofstream file{filename};
+    const Bounds bounds = bounds_of(engine);
+    const bool empty = bounds.empty();
+    file << "x = " << (empty ? 0 : bounds.width())
+         << ", y = " << (empty ? 0 : bounds.height()) << ", rule = B"
+         << digits(engine.birth_rule()) << "/S"
+         << digits(engine.survival_rule()) << '\n';
+    RLE_writer writer{file};
+    int next_y{bounds.top_left.y};
+    if (!empty) {
+        for_each_row(engine, bounds,
+                     [&](int y, const std::vector<Engine::Run>& runs) {
+                         if (y > next_y) {
+                             writer.write(y - next_y, '$');
+                         }
+                         int x{bounds.top_left.x};
+                         for (const Engine::Run& run : runs) {
+                             if (run.position.x > x) {
+                                 writer.write(run.position.x - x, 'b');
+                             }
+                             writer.write(run.length, 'o');
+                             x = run.position.x + run.length;
+                         }
+                         next_y = y;
+                     });
+    }
+    writer.write(1, '!');
+    file << '\n';
+}
 
-void export_as_rle(const std::string& /* filename */,
-                   const Game_of_life_engine& /* engine */) {}
 }  // namespace gol
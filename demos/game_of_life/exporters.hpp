@@ -2,25 +2,27 @@
 #define CPPURSES_DEMOS_GAME_OF_LIFE_EXPORTERS_HPP
 #include <string>
 
-#include "game_of_life_engine.hpp"
+#include "engine.hpp"
 
 namespace gol {
 
-/// Export \p engine state as Life 1.05 file.
+/// Export \p engine state as Life 1.05 file, as a single block.
 void export_as_life_1_05(const std::string& filename,
-                         const Game_of_life_engine& engine);
+                         const Engine& engine);
 
 /// Export \p engine state as Life 1.06 file.
 void export_as_life_1_06(const std::string& filename,
-                         const Game_of_life_engine& engine);
+                         const Engine& engine);
 
 /// Export \p engine state as plaintext file.
 void export_as_plaintext(const std::string& filename,
-                         const Game_of_life_engine& engine);
+                         const Engine& engine);
 
 /// Export \p engine state as RLE file.
+/** Rows are written from the top down, a band at a time, so exporting a
+ *  large pattern does not collect all of its cells first. */
 void export_as_rle(const std::string& filename,
-                   const Game_of_life_engine& engine);
+                   const Engine& engine);
 
 }  // namespace gol
 #endif  // CPPURSES_DEMOS_GAME_OF_LIFE_EXPORTERS_HPP
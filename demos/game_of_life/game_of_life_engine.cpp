@@ -2,6 +2,7 @@
 
 #include <array>
 #include <set>
+#include <vector>
 
 #include "coordinate.hpp"
 
@@ -82,6 +83,29 @@ bool Game_of_life_engine::alive_at(Coordinate position) const {
     return contains(position, alive_cells_);
 }
 
+void Game_of_life_engine::import(const Run_source& source) {
+    source([this](Run run) {
+        for (int i{0}; i < run.length; ++i) {
+            this->add_cell_at({run.position.x + i, run.position.y});
+        }
+    });
+    this->reset_generation_count();
+}
+
+void Game_of_life_engine::for_each_alive_in(Coordinate top_left,
+                                            Coordinate bottom_right,
+                                            const Visitor& visit) const {
+    // Cells are ordered by row, so only the rows in range are walked.
+    auto iter = alive_cells_.lower_bound(top_left);
+    const auto end = alive_cells_.upper_bound(bottom_right);
+    for (; iter != end; ++iter) {
+        const Coordinate position = iter->first;
+        if (position.x >= top_left.x && position.x <= bottom_right.x) {
+            visit(position, iter->second.age);
+        }
+    }
+}
+
 int Game_of_life_engine::alive_neighbor_count(Coordinate position) const {
     int count{0};
     for (Coordinate neighbor : neighbors(position)) {
@@ -97,16 +121,6 @@ void Game_of_life_engine::add_volatiles(Coordinate position) {
     }
 }
 
-void Game_of_life_engine::reset_generation_count() {
-    generation_count_ = 0;
-    generation_count_changed(generation_count_);
-}
-
-void Game_of_life_engine::increment_generation_count() {
-    ++generation_count_;
-    generation_count_changed(generation_count_);
-}
-
 void Game_of_life_engine::add_cell_at(Coordinate position) {
     this->add_volatiles(position);
     alive_cells_[position] = Cell{};
@@ -1,14 +1,59 @@
 #include "get_life_1_05.hpp"
 
 #include <string>
-#include <vector>
+
+#include <cppurses/system/mapped_file.hpp>
 
 #include "coordinate.hpp"
+#include "engine.hpp"
+#include "text_cursor.hpp"
 
 namespace gol {
 
-std::vector<Coordinate> get_life_1_05(const std::string& /* filename */) {
-    return {};
+std::string get_life_1_05(const std::string& filename,
+                          const Engine::Run_visitor& visit) {
+    const cppurses::Mapped_file file{filename};
+    if (!file.is_open()) {
+        return "";
+    }
+    Text_cursor text{file.begin(), file.end()};
+    std::string rule{"3/23"};
+    Coordinate block{0, 0};
+    int y{0};
+    while (!text.done()) {
+        if (text.peek() == '#') {
+            text.get();
+            const char kind = text.get();
+            if (kind == 'P' || kind == 'p') {
+                text.read_int(block.x);
+                text.read_int(block.y);
+                y = block.y;
+            } else if (kind == 'R' || kind == 'r') {
+                rule = to_rule_string(text.read_line());
+                continue;
+            } else if (kind == 'N' || kind == 'n') {
+                rule = "3/23";
+            }
+            text.skip_line();
+            continue;
+        }
+        // A row of the current block, '*' is alive and '.' is dead.
+        int x{block.x};
+        while (!text.done() && text.peek() != '\n') {
+            if (text.get() == '*') {
+                const int first = x;
+                while (text.peek() == '*') {
+                    text.get();
+                    ++x;
+                }
+                visit({{first, y}, x - first + 1});
+            }
+            ++x;
+        }
+        text.get();
+        ++y;
+    }
+    return rule;
 }
 
 }  // namespace gol
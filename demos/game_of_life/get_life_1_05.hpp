@@ -1,14 +1,17 @@
 #ifndef CPPURSES_DEMOS_GAME_OF_LIFE_GET_LIFE_1_05_HPP
 #define CPPURSES_DEMOS_GAME_OF_LIFE_GET_LIFE_1_05_HPP
 #include <string>
-#include <vector>
 
-#include "coordinate.hpp"
+#include "engine.hpp"
 
 namespace gol {
 
-/// Return cell Coordinates from Life 1.05 file.
-std::vector<Coordinate> get_life_1_05(const std::string& filename);
+/// Pass each Run of living cells in a Life 1.05 file to \p visit.
+/** Each "#P x y" block is placed at its given position. Return the rule as a
+ *  "birth/survival" string, or an empty string if the file could not be read.
+ */
+std::string get_life_1_05(const std::string& filename,
+                          const Engine::Run_visitor& visit);
 
 }  // namespace gol
 #endif  // CPPURSES_DEMOS_GAME_OF_LIFE_GET_LIFE_1_05_HPP
@@ -1,33 +1,47 @@
 #include "get_life_1_06.hpp"
-#include <fstream>
+
 #include <string>
-#include <vector>
 
-#include "coordinate.hpp"
+#include <cppurses/system/mapped_file.hpp>
+
+#include "engine.hpp"
+#include "text_cursor.hpp"
 
 namespace gol {
 
-std::vector<Coordinate> get_life_1_06(const std::string& filename) {
-    std::ifstream file{filename};
-    if (file.fail()) {
-        return {};
+void get_life_1_06(const std::string& filename,
+                   const Engine::Run_visitor& visit) {
+    const cppurses::Mapped_file file{filename};
+    if (!file.is_open()) {
+        return;
     }
-    std::vector<Coordinate> cells;
-    std::string first_line;
-    std::getline(file, first_line);
-    while (file) {
-        int x{0};
-        file >> x;
-        if (!file) {
-            break;
+    Text_cursor text{file.begin(), file.end()};
+    Engine::Run run{{0, 0}, 0};
+    while (!text.done()) {
+        if (text.peek() == '#') {
+            text.skip_line();
+            continue;
         }
+        int x{0};
         int y{0};
-        file >> y;
-        if (!file.good()) {
-            break;
+        if (!text.read_int(x) || !text.read_int(y)) {
+            text.skip_line();
+            continue;
         }
-        cells.push_back({x, y});
+        text.skip_line();
+        if (run.length != 0 && y == run.position.y &&
+            x == run.position.x + run.length) {
+            ++run.length;
+            continue;
+        }
+        if (run.length != 0) {
+            visit(run);
+        }
+        run = {{x, y}, 1};
+    }
+    if (run.length != 0) {
+        visit(run);
     }
-    return cells;
 }
+
 }  // namespace gol
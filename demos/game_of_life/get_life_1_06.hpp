@@ -1,14 +1,15 @@
 #ifndef CPPURSES_DEMOS_GAME_OF_LIFE_GET_LIFE_1_06_HPP
 #define CPPURSES_DEMOS_GAME_OF_LIFE_GET_LIFE_1_06_HPP
 #include <string>
-#include <vector>
 
-#include "coordinate.hpp"
+#include "engine.hpp"
 
 namespace gol {
 
-/// Return cell Coordinates from Life 1.06 file.
-std::vector<Coordinate> get_life_1_06(const std::string& filename);
+/// Pass the living cells of a Life 1.06 file to \p visit.
+/** Cells listed next to each other on a row are passed as a single Run. */
+void get_life_1_06(const std::string& filename,
+                   const Engine::Run_visitor& visit);
 
 }  // namespace gol
 #endif  // CPPURSES_DEMOS_GAME_OF_LIFE_GET_LIFE_1_06_HPP
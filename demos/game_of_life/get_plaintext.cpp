@@ -1,15 +1,74 @@
 #include "get_plaintext.hpp"
 
-#include <fstream>
+#include <algorithm>
 #include <string>
-#include <vector>
+
+#include <cppurses/system/mapped_file.hpp>
 
 #include "coordinate.hpp"
+#include "engine.hpp"
+#include "text_cursor.hpp"
+
+namespace {
+using gol::Text_cursor;
+
+/// Return true if \p c is a living cell.
+bool is_alive(char c) {
+    return c == 'O' || c == '*';
+}
+
+/// Read past the comment lines at the cursor, which start with '!'.
+void skip_comments(Text_cursor& text) {
+    while (text.peek() == '!') {
+        text.skip_line();
+    }
+}
+}  // namespace
 
 namespace gol {
 
-std::vector<Coordinate> get_plaintext(const std::string& /* filename */) {
-    return {};
+void get_plaintext(const std::string& filename,
+                   const Engine::Run_visitor& visit) {
+    const cppurses::Mapped_file file{filename};
+    if (!file.is_open()) {
+        return;
+    }
+    Text_cursor text{file.begin(), file.end()};
+    skip_comments(text);
+    const Text_cursor pattern_begin{text};
+    // The size is only known from the text, which is cheap to scan twice.
+    int width{0};
+    int height{0};
+    while (!text.done()) {
+        int column{0};
+        while (!text.done() && text.peek() != '\n') {
+            ++column;
+            if (is_alive(text.get())) {
+                width = std::max(width, column);
+            }
+        }
+        text.get();
+        ++height;
+    }
+    text = pattern_begin;
+    const int x_begin{-(width / 2)};
+    int y{-(height / 2)};
+    while (!text.done()) {
+        int x{x_begin};
+        while (!text.done() && text.peek() != '\n') {
+            if (is_alive(text.get())) {
+                const int first = x;
+                while (is_alive(text.peek())) {
+                    text.get();
+                    ++x;
+                }
+                visit({{first, y}, x - first + 1});
+            }
+            ++x;
+        }
+        text.get();
+        ++y;
+    }
 }
 
 }  // namespace gol
@@ -1,14 +1,15 @@
 #ifndef CPPURSES_DEMOS_GAME_OF_LIFE_GET_PLAINTEXT_HPP
 #define CPPURSES_DEMOS_GAME_OF_LIFE_GET_PLAINTEXT_HPP
 #include <string>
-#include <vector>
 
-#include "coordinate.hpp"
+#include "engine.hpp"
 
 namespace gol {
 
-/// Return cell Coordinates from plaintext file.
-std::vector<Coordinate> get_plaintext(const std::string& filename);
+/// Pass each Run of living cells in a plaintext file to \p visit.
+/** The pattern is centered on (0, 0). */
+void get_plaintext(const std::string& filename,
+                   const Engine::Run_visitor& visit);
 
 }  // namespace gol
 #endif  // CPPURSES_DEMOS_GAME_OF_LIFE_GET_PLAINTEXT_HPP
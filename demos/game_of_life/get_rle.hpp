@@ -1,16 +1,17 @@
 #ifndef CPPURSES_DEMOS_GAME_OF_LIFE_GET_RLE_HPP
 #define CPPURSES_DEMOS_GAME_OF_LIFE_GET_RLE_HPP
 #include <string>
-#include <utility>
-#include <vector>
 
-#include "coordinate.hpp"
+#include "engine.hpp"
 
 namespace gol {
 
-/// Return cell Coordinates and rule string from RLE file.
-std::pair<std::vector<Coordinate>, std::string> get_RLE(
-    const std::string& filename);
+/// Pass each Run of living cells in an RLE file to \p visit.
+/** The file is mapped into memory and decoded as it is read, the pattern is
+ *  centered on (0, 0). Return the rule as a "birth/survival" string, or an
+ *  empty string if the file could not be read. */
+std::string get_RLE(const std::string& filename,
+                    const Engine::Run_visitor& visit);
 
 }  // namespace gol
 #endif  // CPPURSES_DEMOS_GAME_OF_LIFE_GET_RLE_HPP
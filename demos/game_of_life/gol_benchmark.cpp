@@ -0,0 +1,190 @@
+/// Measures generations per second of each Engine on standard RLE patterns.
+/** Usage: gol_benchmark [generations] [file.rle...]
+ *  With no files given, a few well known patterns are run. Exits with 1 if an
+ *  Engine's population differs from Tiled_engine's. */
+#include <chrono>
+#include <cstdint>
+#include <cstdio>
+#include <cstdlib>
+#include <fstream>
+#include <initializer_list>
+#include <iostream>
+#include <memory>
+#include <string>
+#include <utility>
+#include <vector>
+
+#include <unistd.h>
+
+#include <cppurses/system/thread_pool.hpp>
+
+#include "engine.hpp"
+#include "game_of_life_engine.hpp"
+#include "get_rle.hpp"
+#include "hashlife_engine.hpp"
+#include "tiled_engine.hpp"
+
+namespace {
+using namespace gol;
+using cppurses::Thread_pool;
+
+/// Hashlife_engine is also run in steps of 2^jump_exponent generations.
+constexpr int jump_exponent{8};
+
+struct Pattern {
+    std::string name;
+    std::string rle;
+};
+
+const std::vector<Pattern> standard_patterns{
+    {"R-pentomino", "x = 3, y = 3, rule = B3/S23\nb2o$2o$bo!\n"},
+    {"Acorn", "x = 7, y = 3, rule = B3/S23\nbo$3bo$2o2b3o!\n"},
+    {"Gosper glider gun",
+     "x = 36, y = 9, rule = B3/S23\n"
+     "24bo$22bobo$12b2o6b2o12b2o$11bo3bo4b2o12b2o$2o8bo5bo3b2o$"
+     "2o8bo3bob2o4bobo$10bo5bo7bo$11bo3bo$12b2o!\n"},
+    {"Diehard", "x = 8, y = 3, rule = B3/S23\n6bo$2o$bo3b3o!\n"}};
+
+/// Return {birth, survival} neighbor counts from a "B/S" digit rule string.
+std::pair<std::vector<int>, std::vector<int>> parse_rule(
+    const std::string& rule) {
+    std::pair<std::vector<int>, std::vector<int>> result;
+    auto* counts = &result.first;
+    for (char c : rule) {
+        if (c == '/') {
+            counts = &result.second;
+        } else if (c >= '0' && c <= '9') {
+            counts->push_back(c - '0');
+        }
+    }
+    return result;
+}
+
+/// Load \p filename into \p engine, return the time it took in seconds.
+double load(Engine& engine, const std::string& filename) {
+    std::string rule;
+    const auto begin = std::chrono::steady_clock::now();
+    engine.import([&](const Engine::Run_visitor& visit) {
+        rule = get_RLE(filename, visit);
+    });
+    const std::chrono::duration<double> elapsed =
+        std::chrono::steady_clock::now() - begin;
+    const auto rules = parse_rule(rule);
+    engine.set_birth_rule(rules.first);
+    engine.set_survival_rule(rules.second);
+    return elapsed.count();
+}
+
+/// Run \p generations of the loaded pattern, return generations per second.
+/** Runs past \p generations if the engine steps several generations at once. */
+double run(Engine& engine, std::uint32_t generations) {
+    const auto begin = std::chrono::steady_clock::now();
+    while (engine.generation_count() < generations) {
+        engine.get_next_generation();
+    }
+    const std::chrono::duration<double> elapsed =
+        std::chrono::steady_clock::now() - begin;
+    return engine.generation_count() / elapsed.count();
+}
+
+/// Return a new empty file under the system temp directory, or "" on failure.
+std::string make_temp_file() {
+    const char* dir = std::getenv("TMPDIR");
+    std::string path{dir != nullptr && *dir != '\0' ? dir : "/tmp"};
+    path += "/gol_benchmark_XXXXXX";
+    const int fd = ::mkstemp(&path[0]);
+    if (fd == -1) {
+        return "";
+    }
+    ::close(fd);
+    return path;
+}
+
+/// Return the number of living cells in \p engine.
+std::size_t population(const Engine& engine) {
+    std::size_t count{0};
+    engine.for_each_alive([&count](Coordinate, Cell::Age_t) { ++count; });
+    return count;
+}
+
+/// Run each Engine on \p filename, return false if their populations differ.
+bool benchmark(const std::string& name,
+               const std::string& filename,
+               std::uint32_t generations) {
+    Game_of_life_engine map_engine;
+    Tiled_engine single_engine{1};
+    Tiled_engine tiled_engine;
+    Hashlife_engine hashlife_engine;
+    Hashlife_engine jumping_engine;
+    jumping_engine.set_step_exponent(jump_exponent);
+    const double load_time = load(tiled_engine, filename);
+    for (Engine* engine : std::initializer_list<Engine*>{
+             &map_engine, &single_engine, &hashlife_engine, &jumping_engine}) {
+        load(*engine, filename);
+    }
+    std::cout << name << ": loaded " << population(tiled_engine)
+              << " cells in " << load_time * 1000 << " ms\n";
+    const double map_rate = run(map_engine, generations);
+    const double single_rate = run(single_engine, generations);
+    const double tiled_rate = run(tiled_engine, generations);
+    const double hashlife_rate = run(hashlife_engine, generations);
+    const double jumping_rate = run(jumping_engine, generations);
+    const auto threads = Thread_pool::default_thread_count();
+    std::cout << "    " << generations << " generations, population "
+              << population(tiled_engine) << '\n'
+              << "    Game_of_life_engine " << map_rate << " gen/s\n"
+              << "    Tiled_engine, 1 thread " << single_rate << " gen/s\n"
+              << "    Tiled_engine, " << threads
+              << (threads == 1 ? " thread " : " threads ") << tiled_rate
+              << " gen/s\n"
+              << "    Hashlife_engine " << hashlife_rate << " gen/s\n"
+              << "    Hashlife_engine, steps of 2^" << jump_exponent << ' '
+              << jumping_rate << " gen/s\n";
+    bool same{true};
+    const auto check = [&](const std::string& engine_name, const Engine& engine,
+                           const Engine& reference) {
+        if (population(engine) != population(reference)) {
+            std::cerr << name << ": " << engine_name << " population "
+                      << population(engine) << " differs from Tiled_engine "
+                      << population(reference) << " at generation "
+                      << reference.generation_count() << '\n';
+            same = false;
+        }
+    };
+    check("Game_of_life_engine", map_engine, tiled_engine);
+    check("Tiled_engine, 1 thread", single_engine, tiled_engine);
+    check("Hashlife_engine", hashlife_engine, tiled_engine);
+    // The jumping engine can run past generations, catch the reference up.
+    Tiled_engine jump_reference;
+    load(jump_reference, filename);
+    while (jump_reference.generation_count() <
+           jumping_engine.generation_count()) {
+        jump_reference.get_next_generation();
+    }
+    check("Hashlife_engine, steps of 2^" + std::to_string(jump_exponent),
+          jumping_engine, jump_reference);
+    return same;
+}
+}  // namespace
+
+int main(int argc, char* argv[]) {
+    const std::uint32_t generations = argc > 1 ? std::atoi(argv[1]) : 1024;
+    bool same{true};
+    if (argc > 2) {
+        for (int i{2}; i < argc; ++i) {
+            same = benchmark(argv[i], argv[i], generations) && same;
+        }
+        return same ? 0 : 1;
+    }
+    const std::string filename{make_temp_file()};
+    if (filename.empty()) {
+        std::cerr << "Can't create a temporary pattern file\n";
+        return 1;
+    }
+    for (const Pattern& pattern : standard_patterns) {
+        std::ofstream{filename} << pattern.rle;
+        same = benchmark(pattern.name, filename, generations) && same;
+    }
+    std::remove(filename.c_str());
+    return same ? 0 : 1;
+}
@@ -1,9 +1,12 @@
 #include "gol_demo.hpp"
 
-#include <chrono>
 #include <cstdint>
+#include <memory>
 #include <string>
 
+#include "hashlife_engine.hpp"
+#include "tiled_engine.hpp"
+
 namespace gol {
 
 GoL_demo::GoL_demo() {
@@ -15,14 +18,19 @@ GoL_demo::GoL_demo() {
         side_panel.settings.rule_edit.edit_box.set_contents(rule_str);
         side_panel.settings.rule_edit.edit_box.set_cursor(rule_str.size());
     });
-    side_panel.settings.period_set.connect(
-        [this](std::chrono::milliseconds period) {
-            gol_display.set_period(period);
-        });
+    side_panel.settings.rate_set.connect(
+        [this](double rate) { gol_display.set_rate(rate); });
     side_panel.settings.grid_toggled.connect(
         [this]() { gol_display.toggle_grid(); });
     side_panel.settings.fade_toggled.connect(
         [this]() { gol_display.toggle_fade(); });
+    side_panel.settings.tiled_selected.connect(
+        [this]() { gol_display.set_engine(std::make_unique<Tiled_engine>()); });
+    side_panel.settings.hashlife_selected.connect([this]() {
+        gol_display.set_engine(std::make_unique<Hashlife_engine>());
+    });
+    side_panel.settings.step_exponent_set.connect(
+        [this](int exponent) { gol_display.set_step_exponent(exponent); });
     side_panel.settings.clear_request.connect(
         [this]() { gol_display.clear(); });
     side_panel.settings.step_request.connect([this]() { gol_display.step(); });
@@ -69,7 +77,7 @@ GoL_demo::GoL_demo() {
         gol_display.set_offset({gol_display.offset().x, y});
     });
 
-    gol_display.generation_count_changed.connect([this](std::uint32_t count) {
+    gol_display.generation_count_changed.connect([this](std::uint64_t count) {
         side_panel.status.gen_count.update_count(count);
     });
 }
@@ -4,8 +4,11 @@
 #include <cctype>
 #include <chrono>
 #include <cstddef>
+#include <cstdint>
 #include <iterator>
+#include <memory>
 #include <string>
+#include <utility>
 #include <vector>
 
 #include <cppurses/painter/color.hpp>
@@ -13,6 +16,7 @@
 #include <cppurses/painter/painter.hpp>
 #include <cppurses/system/events/key.hpp>
 #include <cppurses/system/events/mouse.hpp>
+#include <cppurses/widget/area.hpp>
 #include <cppurses/widget/focus_policy.hpp>
 #include <cppurses/widget/point.hpp>
 #include <cppurses/widget/widget.hpp>
@@ -41,34 +45,47 @@ std::vector<int> to_vec_int(const std::string& values) {
     }
     return result;
 }
-
-using gol::Coordinate;
-
-template <typename Container_t>
-void apply(Coordinate offset, Container_t& cells) {
-    std::transform(std::begin(cells), std::end(cells), std::begin(cells),
-                   [offset](Coordinate cell) -> Coordinate {
-                       return {cell.x + offset.x, cell.y + offset.y};
-                   });
-}
 }  // namespace
 
 using namespace cppurses;
 namespace gol {
 
 GoL_widget::GoL_widget() {
+    engine_->generation_count_changed.connect(
+        [this](std::uint64_t count) { generation_count_changed(count); });
     this->set_dead(L' ');
     this->focus_policy = Focus_policy::Strong;
 }
 
-void GoL_widget::set_period(Period_t period) {
-    period_ = period;
-    this->update_period();
+void GoL_widget::set_rate(double generations_per_second) {
+    rate_ = generations_per_second;
+}
+
+void GoL_widget::set_engine(std::unique_ptr<Engine> engine) {
+    std::vector<Coordinate> cells;
+    engine_->for_each_alive([&cells](Coordinate position, Cell::Age_t) {
+        cells.push_back(position);
+    });
+    engine->set_birth_rule(engine_->birth_rule());
+    engine->set_survival_rule(engine_->survival_rule());
+    engine->set_step_exponent(step_exponent_);
+    engine->generation_count_changed.connect(
+        [this](std::uint64_t count) { generation_count_changed(count); });
+    engine->import(cells);
+    engine_ = std::move(engine);
+    this->repaint();
+}
+
+void GoL_widget::set_step_exponent(int exponent) {
+    step_exponent_ = exponent;
+    engine_->set_step_exponent(exponent);
 }
 
 void GoL_widget::start() {
     if (!running_) {
-        this->enable_animation(period_);
+        last_frame_ = std::chrono::steady_clock::now();
+        due_ = 0.0;
+        this->enable_animation(frame_period_);
         running_ = true;
     }
 }
@@ -84,19 +101,20 @@ void GoL_widget::step() {
     if (running_) {
         return;
     }
-    engine_.get_next_generation();
+    engine_->get_next_generation();
+    ++unpainted_generations_;
     this->update();
 }
 
 void GoL_widget::set_dead(const Glyph& dead_look) {
     this->wallpaper = dead_look;
     dead_look_ = dead_look;
-    this->update();
+    this->repaint();
 }
 
 void GoL_widget::enable_fade(bool enabled) {
     fade_ = enabled;
-    this->update();
+    this->repaint();
 }
 
 void GoL_widget::set_rules(const std::string& rule_string) {
@@ -105,15 +123,15 @@ void GoL_widget::set_rules(const std::string& rule_string) {
     if (delim != std::end(rule_string)) {
         const std::string birth{std::begin(rule_string), delim};
         const std::string survival{std::next(delim), std::end(rule_string)};
-        engine_.set_birth_rule(to_vec_int(birth));
-        engine_.set_survival_rule(to_vec_int(survival));
+        engine_->set_birth_rule(to_vec_int(birth));
+        engine_->set_survival_rule(to_vec_int(survival));
         rule_changed(rule_string);
     }
 }
 
 void GoL_widget::clear() {
-    engine_.kill_all();
-    this->update();
+    engine_->kill_all();
+    this->repaint();
 }
 
 void GoL_widget::toggle_grid() {
@@ -123,72 +141,122 @@ void GoL_widget::toggle_grid() {
     } else {
         this->set_dead(dead_look_);
     }
-    this->update();
+    this->repaint();
 }
 
 void GoL_widget::import(const std::string& filename) {
     const auto ft = get_filetype(filename);
-    std::vector<Coordinate> cells;
-    std::string rule{"3/23"};
-    if (ft == FileType::Life_1_05) {
-        cells = get_life_1_05(filename);
-    } else if (ft == FileType::Life_1_06) {
-        cells = get_life_1_06(filename);
-    } else if (ft == FileType::Plaintext) {
-        cells = get_plaintext(filename);
-    } else if (ft == FileType::RLE) {
-        auto cells_rule = get_RLE(filename);
-        cells = cells_rule.first;
-        rule = cells_rule.second;
-    }
-    this->set_rules(rule);
-    apply(offset_, cells);
-    engine_.import(cells);
-    this->update();
+    const Coordinate offset = offset_;
+    std::string rule;
+    // Runs are decoded from the file straight into the engine.
+    engine_->import([&](const Engine::Run_visitor& visit) {
+        const auto shift = [offset, &visit](Engine::Run run) {
+            run.position.x += offset.x;
+            run.position.y += offset.y;
+            visit(run);
+        };
+        if (ft == FileType::Life_1_05) {
+            rule = get_life_1_05(filename, shift);
+        } else if (ft == FileType::Life_1_06) {
+            get_life_1_06(filename, shift);
+        } else if (ft == FileType::Plaintext) {
+            get_plaintext(filename, shift);
+        } else if (ft == FileType::RLE) {
+            rule = get_RLE(filename, shift);
+        }
+    });
+    this->set_rules(rule.empty() ? "3/23" : rule);
+    this->repaint();
 }
 
 void GoL_widget::export_as(const std::string& filename) {
     const auto ext = get_extension(filename);
     if (ext == "lif") {
-        export_as_life_1_05(filename, engine_);
+        export_as_life_1_05(filename, *engine_);
     } else if (ext == "life") {
-        export_as_life_1_06(filename, engine_);
+        export_as_life_1_06(filename, *engine_);
     } else if (ext == "cell") {
-        export_as_plaintext(filename, engine_);
+        export_as_plaintext(filename, *engine_);
     } else if (ext == "rle") {
-        export_as_rle(filename, engine_);
+        export_as_rle(filename, *engine_);
     }
 }
 
 void GoL_widget::set_offset(Coordinate offset) {
     offset_ = offset;
     offset_changed(offset_);
-    this->update();
+    this->repaint();
 }
 
 bool GoL_widget::paint_event() {
+    if (this->width() == 0 || this->height() == 0) {
+        return Widget::paint_event();
+    }
     Painter p{*this};
-    for (const auto& coord_cell : engine_) {
-        p.put(this->get_look(coord_cell.second.age),
-              transform_from_engine(coord_cell.first));
+    auto area = p.region();
+    if (area.empty()) {
+        return Widget::paint_event();
+    }
+    // Only the cells in view are visited, however large the pattern is, so
+    // each position is within the region and needs no bounds check.
+    const Coordinate top_left = transform_from_display(Point{0, 0});
+    const Coordinate bottom_right =
+        transform_from_display(Point{this->width() - 1, this->height() - 1});
+    const auto local = [top_left](Coordinate position) {
+        return Point{static_cast<std::size_t>(position.x - top_left.x),
+                     static_cast<std::size_t>(position.y - top_left.y)};
+    };
+    const auto put = [this, &area, local](Coordinate position,
+                                          Cell::Age_t age) {
+        area.put(this->get_look(age), local(position));
+    };
+    const bool only_changes =
+        !repaint_all_ && unpainted_generations_ == 1 &&
+        engine_->for_each_change_in(
+            top_left, bottom_right, put, [&area, local](Coordinate position) {
+                area.erase(local(position));
+            });
+    if (only_changes) {
+        p.keep_previous();
+    } else {
+        engine_->for_each_alive_in(top_left, bottom_right, put);
     }
+    repaint_all_ = false;
+    unpainted_generations_ = 0;
     return Widget::paint_event();
 }
 
 bool GoL_widget::mouse_press_event(const Mouse::State& mouse) {
     const Coordinate engine_position = transform_from_display(mouse.local);
     if (mouse.button == Mouse::Button::Right) {
-        engine_.kill(engine_position);
+        engine_->kill(engine_position);
     } else {
-        engine_.give_life(engine_position);
+        engine_->give_life(engine_position);
     }
-    this->update();
+    this->repaint();
     return Widget::mouse_press_event(mouse);
 }
 
 bool GoL_widget::timer_event() {
-    engine_.get_next_generation();
-    this->update();
+    using Clock = std::chrono::steady_clock;
+    const auto now = Clock::now();
+    const std::chrono::duration<double> elapsed = now - last_frame_;
+    last_frame_ = now;
+    due_ += elapsed.count() * rate_;
+    const bool advancing = due_ >= 1.0;
+    // Catch up for at most half a frame, a backlog beyond that is dropped.
+    const auto deadline = now + frame_period_ / 2;
+    while (due_ >= 1.0 && Clock::now() < deadline) {
+        engine_->get_next_generation();
+        ++unpainted_generations_;
+        due_ -= 1.0;
+    }
+    due_ = std::min(due_, 1.0);
+    // Computed on worker threads while this generation is painted.
+    engine_->prepare_next_generation();
+    if (advancing) {
+        this->update();
+    }
     return Widget::timer_event();
 }
 
@@ -207,22 +275,20 @@ bool GoL_widget::key_press_event(const Key::State& keyboard) {
     return Widget::key_press_event(keyboard);
 }
 
-void GoL_widget::update_period() {
-    if (this->running_) {
-        this->disable_animation();
-        this->enable_animation(period_);
-    }
+bool GoL_widget::resize_event(Area new_size, Area old_size) {
+    // The view is centered, so every cell has moved on screen.
+    this->repaint();
+    return Widget::resize_event(new_size, old_size);
 }
 
-Point GoL_widget::transform_from_engine(Coordinate position) const {
-    const int height = static_cast<int>(this->height());
-    const int width = static_cast<int>(this->width());
-    const int x{position.x + static_cast<int>(width / 2) - offset_.x};
-    const int y{position.y + static_cast<int>(height / 2) - offset_.y};
-    if (x >= 0 && x < width && y >= 0 && y < height) {
-        return Point{static_cast<std::size_t>(x), static_cast<std::size_t>(y)};
-    }
-    return Point{std::size_t(-1), std::size_t(-1)};
+bool GoL_widget::enable_event() {
+    this->repaint();
+    return Widget::enable_event();
+}
+
+void GoL_widget::repaint() {
+    repaint_all_ = true;
+    this->update();
 }
 
 Coordinate GoL_widget::transform_from_display(Point p) const {
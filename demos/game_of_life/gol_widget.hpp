@@ -1,6 +1,8 @@
 #ifndef CPPURSES_DEMOS_GAME_OF_LIFE_GOL_WIDGET_HPP
 #define CPPURSES_DEMOS_GAME_OF_LIFE_GOL_WIDGET_HPP
 #include <chrono>
+#include <cstdint>
+#include <memory>
 #include <string>
 
 #include <signals/signal.hpp>
@@ -8,10 +10,12 @@
 #include <cppurses/painter/glyph.hpp>
 #include <cppurses/system/events/key.hpp>
 #include <cppurses/system/events/mouse.hpp>
+#include <cppurses/widget/area.hpp>
 #include <cppurses/widget/point.hpp>
 #include <cppurses/widget/widget.hpp>
 
-#include "game_of_life_engine.hpp"
+#include "engine.hpp"
+#include "tiled_engine.hpp"
 
 namespace gol {
 
@@ -21,8 +25,17 @@ class GoL_widget : public cppurses::Widget {
 
     GoL_widget();
 
-    /// Change the animation rate, in milliseconds.
-    void set_period(Period_t period);
+    /// Set the target number of generations computed per second.
+    /** Independent of the frame rate, each frame advances as many generations
+     *  as are due, and the next generation is computed in the background while
+     *  the last one is displayed. */
+    void set_rate(double generations_per_second);
+
+    /// Move the pattern and rules into \p engine, which is used from now on.
+    void set_engine(std::unique_ptr<Engine> engine);
+
+    /// Advance 2^exponent generations per step, if the engine supports it.
+    void set_step_exponent(int exponent);
 
     /// Start animation, no-op if already running.
     void start();
@@ -72,29 +85,39 @@ class GoL_widget : public cppurses::Widget {
 
     sig::Signal<void(Coordinate)> offset_changed;
     sig::Signal<void(const std::string&)> rule_changed;
+    sig::Signal<void(std::uint64_t)> generation_count_changed;
 
    protected:
     bool paint_event() override;
     bool mouse_press_event(const cppurses::Mouse::State& mouse) override;
     bool timer_event() override;
     bool key_press_event(const cppurses::Key::State& keyboard) override;
+    bool resize_event(cppurses::Area new_size,
+                      cppurses::Area old_size) override;
+    bool enable_event() override;
 
    private:
-    Game_of_life_engine engine_;
+    std::unique_ptr<Engine> engine_{std::make_unique<Tiled_engine>()};
     cppurses::Glyph dead_look_{L' '};
     bool running_{false};
     bool fade_{true};
     bool grid_{false};
-    Period_t period_{120};
     Coordinate offset_{0, 0};
+    int step_exponent_{0};
+
+    // Generations are stepped on each frame, at rate_ generations per second.
+    Period_t frame_period_{33};
+    double rate_{10.0};
+    double due_{0.0};
+    std::chrono::steady_clock::time_point last_frame_;
 
-    /// Update the period if currently running.
-    void update_period();
+    // A single generation stepped since the last paint_event only repaints the
+    // cells it changed, anything else repaints every cell in view.
+    std::uint32_t unpainted_generations_{0};
+    bool repaint_all_{true};
 
-    /// Convert signed Coordinates from engine to display positions.
-    /** Engine coordinate (0,0) is at the center of the display. Return max
-     *  values for x and y if transformation cannot fit on the display. */
-    cppurses::Point transform_from_engine(Coordinate position) const;
+    /// Repaint every cell in view on the next paint_event.
+    void repaint();
 
     /// Convert unsigned display position to engine Coordinates.
     /** Engine coordinate (0,0) is at the center of the display. */
@@ -102,10 +125,6 @@ class GoL_widget : public cppurses::Widget {
 
     /// Return a Glyph to represent a Cell of a given \p age.
     cppurses::Glyph get_look(typename Cell::Age_t age) const;
-
-   public:
-    sig::Signal<void(std::uint32_t)>& generation_count_changed{
-        engine_.generation_count_changed};
 };
 }  // namespace gol
 #endif  // CPPURSES_DEMOS_GAME_OF_LIFE_GOL_WIDGET_HPP
@@ -0,0 +1,377 @@
+#include "hashlife_engine.hpp"
+
+#include <algorithm>
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+#include "coordinate.hpp"
+
+namespace gol {
+
+constexpr std::size_t Hashlife_engine::default_node_limit;
+constexpr Hashlife_engine::Id Hashlife_engine::none;
+constexpr Hashlife_engine::Id Hashlife_engine::dead;
+constexpr Hashlife_engine::Id Hashlife_engine::alive;
+
+std::size_t Hashlife_engine::Children_hash::operator()(
+    const Children& c) const {
+    std::uint64_t hash{0};
+    for (Id id : c) {
+        hash = (hash ^ id) * 0x100000001b3ULL;
+        hash ^= hash >> 29;
+    }
+    return static_cast<std::size_t>(hash);
+}
+
+Hashlife_engine::Hashlife_engine(std::size_t node_limit)
+    : node_limit_{node_limit},
+      birth_{this->birth_mask()},
+      survival_{this->survival_mask()} {
+    nodes_.push_back(Node{none, none, none, none, none, 0, 0});
+    nodes_.push_back(Node{none, none, none, none, none, 1, 0});
+    this->kill_all();
+}
+
+void Hashlife_engine::get_next_generation() {
+    this->check_rules();
+    // The root's center half is computed, so the pattern must fit well inside.
+    while (nodes_[root_].level < step_exponent_ + 3 || !this->padded()) {
+        this->expand();
+    }
+    const long long quarter{1LL << (nodes_[root_].level - 2)};
+    root_ = this->successor(root_);
+    x_ += quarter;
+    y_ += quarter;
+    if (this->node_count() > node_limit_) {
+        this->collect_garbage();
+    }
+    this->increment_generation_count(std::uint64_t{1} << step_exponent_);
+}
+
+void Hashlife_engine::give_life(Coordinate position) {
+    if (this->set_cell(position, true)) {
+        this->reset_generation_count();
+    }
+}
+
+void Hashlife_engine::kill(Coordinate position) {
+    if (this->set_cell(position, false)) {
+        this->reset_generation_count();
+    }
+}
+
+void Hashlife_engine::kill_all() {
+    nodes_.resize(2);
+    free_.clear();
+    index_.clear();
+    empty_.assign(1, dead);
+    root_ = this->empty(3);
+    x_ = -4;
+    y_ = -4;
+    this->reset_generation_count();
+}
+
+bool Hashlife_engine::alive_at(Coordinate position) const {
+    long long x = position.x - x_;
+    long long y = position.y - y_;
+    Id n = root_;
+    long long half{1LL << nodes_[n].level};
+    if (x < 0 || y < 0 || x >= half || y >= half) {
+        return false;
+    }
+    while (nodes_[n].level > 0 && nodes_[n].population > 0) {
+        half /= 2;
+        const Node& node = nodes_[n];
+        if (y < half) {
+            n = x < half ? node.nw : node.ne;
+        } else {
+            n = x < half ? node.sw : node.se;
+        }
+        x %= half;
+        y %= half;
+    }
+    return n == alive;
+}
+
+void Hashlife_engine::import(const Run_source& source) {
+    source([this](Run run) {
+        for (int i{0}; i < run.length; ++i) {
+            this->set_cell({run.position.x + i, run.position.y}, true);
+        }
+    });
+    this->reset_generation_count();
+}
+
+void Hashlife_engine::for_each_alive_in(Coordinate top_left,
+                                        Coordinate bottom_right,
+                                        const Visitor& visit) const {
+    this->visit(root_, x_, y_, top_left, bottom_right, visit);
+}
+
+void Hashlife_engine::set_step_exponent(int exponent) {
+    exponent = std::max(0, std::min(exponent, 24));
+    if (exponent != step_exponent_) {
+        step_exponent_ = exponent;
+        this->clear_results();
+    }
+}
+
+Hashlife_engine::Id Hashlife_engine::join(Id nw, Id ne, Id sw, Id se) {
+    const Children children{{nw, ne, sw, se}};
+    const auto at = index_.find(children);
+    if (at != std::end(index_)) {
+        return at->second;
+    }
+    const Node node{nw,
+                    ne,
+                    sw,
+                    se,
+                    none,
+                    nodes_[nw].population + nodes_[ne].population +
+                        nodes_[sw].population + nodes_[se].population,
+                    nodes_[nw].level + 1};
+    Id id;
+    if (free_.empty()) {
+        id = static_cast<Id>(nodes_.size());
+        nodes_.push_back(node);
+    } else {
+        id = free_.back();
+        free_.pop_back();
+        nodes_[id] = node;
+    }
+    index_.emplace(children, id);
+    return id;
+}
+
+Hashlife_engine::Id Hashlife_engine::empty(int level) {
+    while (static_cast<int>(empty_.size()) <= level) {
+        const Id e = empty_.back();
+        empty_.push_back(this->join(e, e, e, e));
+    }
+    return empty_[level];
+}
+
+Hashlife_engine::Id Hashlife_engine::center(Id n) {
+    const Node node = nodes_[n];
+    return this->join(nodes_[node.nw].se, nodes_[node.ne].sw,
+                      nodes_[node.sw].ne, nodes_[node.se].nw);
+}
+
+Hashlife_engine::Id Hashlife_engine::successor(Id n) {
+    const Node node = nodes_[n];
+    if (node.result != none) {
+        return node.result;
+    }
+    Id result;
+    if (node.population == 0) {
+        result = this->empty(node.level - 1);
+    } else if (node.level == 2) {
+        result = this->base_successor(n);
+    } else {
+        const Node nw = nodes_[node.nw];
+        const Node ne = nodes_[node.ne];
+        const Node sw = nodes_[node.sw];
+        const Node se = nodes_[node.se];
+        // Nine overlapping squares of half this size, a 3x3 grid.
+        Id grid[3][3]{
+            {node.nw, this->join(nw.ne, ne.nw, nw.se, ne.sw), node.ne},
+            {this->join(nw.sw, nw.se, sw.nw, sw.ne),
+             this->join(nw.se, ne.sw, sw.ne, se.nw),
+             this->join(ne.sw, ne.se, se.nw, se.ne)},
+            {node.sw, this->join(sw.ne, se.nw, sw.se, se.sw), node.se}};
+        // Two half steps if a full step is wanted, else just the second one.
+        const bool full_step{node.level - 2 <= step_exponent_};
+        for (auto& row : grid) {
+            for (Id& square : row) {
+                square = full_step ? this->successor(square)
+                                   : this->center(square);
+            }
+        }
+        const auto quadrant = [this, &grid](int x, int y) {
+            return this->successor(
+                this->join(grid[y][x], grid[y][x + 1], grid[y + 1][x],
+                           grid[y + 1][x + 1]));
+        };
+        const Id result_nw = quadrant(0, 0);
+        const Id result_ne = quadrant(1, 0);
+        const Id result_sw = quadrant(0, 1);
+        const Id result_se = quadrant(1, 1);
+        result = this->join(result_nw, result_ne, result_sw, result_se);
+    }
+    nodes_[n].result = result;
+    return result;
+}
+
+Hashlife_engine::Id Hashlife_engine::base_successor(Id n) {
+    // 4x4 cells, bit x + 4y, the center 2x2 are advanced one generation.
+    std::uint16_t cells{0};
+    const Node node = nodes_[n];
+    const Id quadrants[4]{node.nw, node.ne, node.sw, node.se};
+    for (int q{0}; q < 4; ++q) {
+        const Node& quadrant = nodes_[quadrants[q]];
+        const Id leaves[4]{quadrant.nw, quadrant.ne, quadrant.sw, quadrant.se};
+        for (int l{0}; l < 4; ++l) {
+            const int x = (q % 2) * 2 + l % 2;
+            const int y = (q / 2) * 2 + l / 2;
+            if (leaves[l] == alive) {
+                cells |= 1 << (x + 4 * y);
+            }
+        }
+    }
+    const auto next = [cells, this](int x, int y) {
+        int count{0};
+        for (int dy{-1}; dy <= 1; ++dy) {
+            for (int dx{-1}; dx <= 1; ++dx) {
+                if (dx != 0 || dy != 0) {
+                    count += (cells >> (x + dx + 4 * (y + dy))) & 1;
+                }
+            }
+        }
+        const bool was_alive = (cells >> (x + 4 * y)) & 1;
+        const auto rule = was_alive ? survival_ : birth_;
+        return ((rule >> count) & 1) != 0 ? alive : dead;
+    };
+    return this->join(next(1, 1), next(2, 1), next(1, 2), next(2, 2));
+}
+
+void Hashlife_engine::expand() {
+    const Node root = nodes_[root_];
+    const Id e = this->empty(root.level - 1);
+    const Id nw = this->join(e, e, e, root.nw);
+    const Id ne = this->join(e, e, root.ne, e);
+    const Id sw = this->join(e, root.sw, e, e);
+    const Id se = this->join(root.se, e, e, e);
+    root_ = this->join(nw, ne, sw, se);
+    const long long half{1LL << (root.level - 1)};
+    x_ -= half;
+    y_ -= half;
+}
+
+bool Hashlife_engine::padded() const {
+    const Node& root = nodes_[root_];
+    const auto inner = [this](Id quadrant, Id Node::*toward_center) {
+        const Id child = nodes_[quadrant].*toward_center;
+        return nodes_[quadrant].population ==
+               nodes_[nodes_[child].*toward_center].population;
+    };
+    return inner(root.nw, &Node::se) && inner(root.ne, &Node::sw) &&
+           inner(root.sw, &Node::ne) && inner(root.se, &Node::nw);
+}
+
+Hashlife_engine::Id Hashlife_engine::set(Id n,
+                                         long long x,
+                                         long long y,
+                                         bool is_alive) {
+    const Node node = nodes_[n];
+    if (node.level == 0) {
+        return is_alive ? alive : dead;
+    }
+    const long long half{1LL << (node.level - 1)};
+    Id nw = node.nw, ne = node.ne, sw = node.sw, se = node.se;
+    if (y < half) {
+        if (x < half) {
+            nw = this->set(nw, x, y, is_alive);
+        } else {
+            ne = this->set(ne, x - half, y, is_alive);
+        }
+    } else {
+        if (x < half) {
+            sw = this->set(sw, x, y - half, is_alive);
+        } else {
+            se = this->set(se, x - half, y - half, is_alive);
+        }
+    }
+    return this->join(nw, ne, sw, se);
+}
+
+bool Hashlife_engine::set_cell(Coordinate position, bool is_alive) {
+    if (this->alive_at(position) == is_alive) {
+        return false;
+    }
+    const auto outside = [this, position] {
+        const long long length{1LL << nodes_[root_].level};
+        return position.x < x_ || position.y < y_ ||
+               position.x >= x_ + length || position.y >= y_ + length;
+    };
+    while (outside()) {
+        this->expand();
+    }
+    root_ = this->set(root_, position.x - x_, position.y - y_, is_alive);
+    return true;
+}
+
+void Hashlife_engine::visit(Id n,
+                            long long x,
+                            long long y,
+                            Coordinate top_left,
+                            Coordinate bottom_right,
+                            const Visitor& visitor) const {
+    const Node& node = nodes_[n];
+    const long long length{1LL << node.level};
+    if (node.population == 0 || x > bottom_right.x || y > bottom_right.y ||
+        x + length <= top_left.x || y + length <= top_left.y) {
+        return;
+    }
+    if (node.level == 0) {
+        visitor({static_cast<int>(x), static_cast<int>(y)}, 0);
+        return;
+    }
+    const long long half{length / 2};
+    this->visit(node.nw, x, y, top_left, bottom_right, visitor);
+    this->visit(node.ne, x + half, y, top_left, bottom_right, visitor);
+    this->visit(node.sw, x, y + half, top_left, bottom_right, visitor);
+    this->visit(node.se, x + half, y + half, top_left, bottom_right, visitor);
+}
+
+void Hashlife_engine::check_rules() {
+    const auto birth = this->birth_mask();
+    const auto survival = this->survival_mask();
+    if (birth != birth_ || survival != survival_) {
+        birth_ = birth;
+        survival_ = survival;
+        this->clear_results();
+    }
+}
+
+void Hashlife_engine::clear_results() {
+    for (Node& node : nodes_) {
+        node.result = none;
+    }
+}
+
+void Hashlife_engine::collect_garbage() {
+    std::vector<bool> marked(nodes_.size(), false);
+    std::vector<Id> stack{root_};
+    stack.insert(std::end(stack), std::begin(empty_), std::end(empty_));
+    while (!stack.empty()) {
+        const Id n = stack.back();
+        stack.pop_back();
+        if (marked[n]) {
+            continue;
+        }
+        marked[n] = true;
+        const Node& node = nodes_[n];
+        if (node.level > 0) {
+            stack.insert(std::end(stack), {node.nw, node.ne, node.sw, node.se});
+        }
+    }
+    marked[dead] = true;
+    marked[alive] = true;
+    // Results are kept only if the node they point to survived.
+    index_.clear();
+    free_.clear();
+    for (Id n{alive + 1}; n < nodes_.size(); ++n) {
+        Node& node = nodes_[n];
+        if (!marked[n]) {
+            free_.push_back(n);
+            continue;
+        }
+        if (node.result != none && !marked[node.result]) {
+            node.result = none;
+        }
+        index_.emplace(Children{{node.nw, node.ne, node.sw, node.se}}, n);
+    }
+}
+
+}  // namespace gol
@@ -0,0 +1,135 @@
+#ifndef CPPURSES_DEMOS_GAME_OF_LIFE_HASHLIFE_ENGINE_HPP
+#define CPPURSES_DEMOS_GAME_OF_LIFE_HASHLIFE_ENGINE_HPP
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <unordered_map>
+#include <vector>
+
+#include "coordinate.hpp"
+#include "engine.hpp"
+
+namespace gol {
+
+/// Engine that stores the pattern as a quadtree of canonical, shared nodes.
+/** Identical squares anywhere in the pattern, at any time, are the same node.
+ *  Each node memoizes the center of its square some generations ahead, so
+ *  repetitive and periodic patterns are computed once and then looked up. A
+ *  call to get_next_generation() advances 2^step_exponent generations at once.
+ *  Cells are not aged, every Cell is reported with an age of 0.
+ *
+ *  Nodes no longer reachable from the pattern are collected after a step if
+ *  more than the node limit are allocated. */
+class Hashlife_engine : public Engine {
+   public:
+    /// Default number of nodes kept before garbage is collected, ~100MB.
+    static constexpr std::size_t default_node_limit{1 << 20};
+
+    /// Collect garbage once more than \p node_limit nodes are allocated.
+    explicit Hashlife_engine(std::size_t node_limit = default_node_limit);
+
+    void get_next_generation() override;
+    void give_life(Coordinate position) override;
+    void kill(Coordinate position) override;
+    void kill_all() override;
+    bool alive_at(Coordinate position) const override;
+    void import(const Run_source& source) override;
+    using Engine::import;
+    void for_each_alive_in(Coordinate top_left,
+                           Coordinate bottom_right,
+                           const Visitor& visit) const override;
+
+    /// Advance 2^exponent generations per step, exponent is clamped to [0,24].
+    void set_step_exponent(int exponent) override;
+
+    /// Return the number of nodes currently allocated.
+    std::size_t node_count() const { return nodes_.size() - free_.size(); }
+
+   private:
+    using Id = std::uint32_t;
+    static constexpr Id none{static_cast<Id>(-1)};
+    static constexpr Id dead{0};
+    static constexpr Id alive{1};
+
+    /// A square of 2^level cells a side, level 0 nodes are single cells.
+    struct Node {
+        Id nw;
+        Id ne;
+        Id sw;
+        Id se;
+        /// Center square, 2^(level - 1) a side, one step ahead, or none.
+        Id result;
+        std::uint64_t population;
+        int level;
+    };
+
+    using Children = std::array<Id, 4>;
+
+    struct Children_hash {
+        std::size_t operator()(const Children& c) const;
+    };
+
+    std::vector<Node> nodes_;
+    std::vector<Id> free_;
+    std::unordered_map<Children, Id, Children_hash> index_;
+    std::vector<Id> empty_;  // Empty node of each level.
+    std::size_t node_limit_;
+
+    Id root_;
+    // Cell coordinates of the root's top left corner.
+    long long x_;
+    long long y_;
+
+    int step_exponent_{0};
+    // Rules that the memoized results were computed with.
+    std::uint16_t birth_;
+    std::uint16_t survival_;
+
+    /// Return the canonical node with the given children.
+    Id join(Id nw, Id ne, Id sw, Id se);
+
+    /// Return the canonical empty node of \p level.
+    Id empty(int level);
+
+    /// Return the center square of \p n, one level down, not advanced.
+    Id center(Id n);
+
+    /// Return the center of \p n advanced by 2^min(level - 2, step exponent).
+    Id successor(Id n);
+
+    /// Successor of a level 2 node, computed cell by cell.
+    Id base_successor(Id n);
+
+    /// Double the root's size around its center.
+    void expand();
+
+    /// Return true if the root's live cells are all in its central 1/16th.
+    /** Then no cell can escape the root's center half within one step. */
+    bool padded() const;
+
+    /// Return \p n with the cell at (x, y) set, relative to n's top left.
+    Id set(Id n, long long x, long long y, bool is_alive);
+
+    /// Set the cell at \p position, return false if it was already so.
+    bool set_cell(Coordinate position, bool is_alive);
+
+    /// Visit living cells of \p n, with top left at (x, y), within the bounds.
+    void visit(Id n,
+               long long x,
+               long long y,
+               Coordinate top_left,
+               Coordinate bottom_right,
+               const Visitor& visitor) const;
+
+    /// Drop memoized results if the rules have changed since computing them.
+    void check_rules();
+
+    /// Forget every memoized result.
+    void clear_results();
+
+    /// Free nodes not reachable from the root or the empty nodes.
+    void collect_garbage();
+};
+
+}  // namespace gol
+#endif  // CPPURSES_DEMOS_GAME_OF_LIFE_HASHLIFE_ENGINE_HPP
@@ -1,7 +1,7 @@
 #include "settings_box.hpp"
 
 #include <cctype>
-#include <chrono>
+#include <cmath>
 #include <string>
 
 #include <cppurses/painter/color.hpp>
@@ -40,11 +40,31 @@ Start_pause_btns::Start_pause_btns() : Toggle_button{"Start", "Pause"} {
     bottom.brush.set_foreground(Color::White);
 }
 
-Period_box::Period_box() {
+Speed_box::Speed_box() {
     this->height_policy.fixed(1);
-    units.brush.set_background(Color::White);
-    units.brush.set_foreground(Color::Gray);
-    units.width_policy.fixed(2);
+    rate_display.brush.set_background(Color::White);
+    rate_display.brush.set_foreground(Color::Gray);
+    rate_display.width_policy.fixed(6);
+    rate_display.set_alignment(Alignment::Right);
+
+    slider.percent_changed.connect([this](float percent) {
+        const double rate{std::pow(1000.0, percent)};
+        rate_display.set_contents(std::to_string(std::lround(rate)) + "/s");
+        rate_set(rate);
+    });
+    slider.set_percent(1.f / 3.f);
+}
+
+Engine_box::Engine_box() {
+    this->height_policy.fixed(2);
+    engine_select.cycle_box.add_option("Tiled").connect(
+        [this] { tiled_selected(); });
+    engine_select.cycle_box.add_option("HashLife").connect(
+        [this] { hashlife_selected(); });
+    for (int exponent{0}; exponent <= 16; exponent += 2) {
+        step_select.cycle_box.add_option("2^" + std::to_string(exponent))
+            .connect([this, exponent] { step_exponent_set(exponent); });
+    }
 }
 
 Grid_fade::Grid_fade() {
@@ -53,13 +73,10 @@ Grid_fade::Grid_fade() {
 }
 
 Settings_box::Settings_box() {
-    this->height_policy.fixed(8);
+    this->height_policy.fixed(10);
     this->border.enable();
     this->border.segments.disable_all();
     this->border.segments.north.enable();
     this->border.segments.north = Glyph{L'─', foreground(Color::Blue)};
-
-    period_edit.value_set.connect(
-        [this](int value) { period_set(std::chrono::milliseconds{value}); });
 }
 }  // namespace gol
@@ -1,6 +1,5 @@
 #ifndef CPPURSES_DEMOS_GAME_OF_LIFE_SETTINGS_BOX_HPP
 #define CPPURSES_DEMOS_GAME_OF_LIFE_SETTINGS_BOX_HPP
-#include <chrono>
 #include <string>
 
 #include <signals/signal.hpp>
@@ -11,8 +10,9 @@
 #include <cppurses/widget/layouts/vertical.hpp>
 #include <cppurses/widget/widgets/checkbox.hpp>
 #include <cppurses/widget/widgets/confirm_button.hpp>
+#include <cppurses/widget/widgets/horizontal_slider.hpp>
 #include <cppurses/widget/widgets/label.hpp>
-#include <cppurses/widget/widgets/labeled_number_edit.hpp>
+#include <cppurses/widget/widgets/labeled_cycle_box.hpp>
 #include <cppurses/widget/widgets/line_edit.hpp>
 #include <cppurses/widget/widgets/push_button.hpp>
 #include <cppurses/widget/widgets/toggle_button.hpp>
@@ -46,15 +46,29 @@ struct Start_pause_btns : cppurses::Toggle_button {
     sig::Signal<void()>& pause_requested{bottom.clicked};
 };
 
-struct Period_box : cppurses::layout::Horizontal {
-    Period_box();
+/// Slider for the generations per second, on a log scale from 1 to 1000.
+struct Speed_box : cppurses::layout::Horizontal {
+    Speed_box();
 
-    cppurses::Labeled_number_edit<unsigned>& value_edit{
-        this->make_child<cppurses::Labeled_number_edit<unsigned>>("▸Period ",
-                                                                  120)};
-    cppurses::Label& units{this->make_child<cppurses::Label>("ms")};
+    cppurses::Horizontal_slider& slider{
+        this->make_child<cppurses::Horizontal_slider>()};
+    cppurses::Label& rate_display{this->make_child<cppurses::Label>()};
 
-    sig::Signal<void(unsigned)>& value_set{value_edit.value_set};
+    sig::Signal<void(double)> rate_set;
+};
+
+/// Chooses the Engine, and the generations a HashLife step advances.
+struct Engine_box : cppurses::layout::Vertical {
+    Engine_box();
+
+    cppurses::Labeled_cycle_box& engine_select{
+        this->make_child<cppurses::Labeled_cycle_box>("Engine")};
+    cppurses::Labeled_cycle_box& step_select{
+        this->make_child<cppurses::Labeled_cycle_box>("Step")};
+
+    sig::Signal<void()> tiled_selected;
+    sig::Signal<void()> hashlife_selected;
+    sig::Signal<void(int)> step_exponent_set;
 };
 
 struct Grid_fade : cppurses::layout::Horizontal {
@@ -69,18 +83,22 @@ struct Grid_fade : cppurses::layout::Horizontal {
 struct Settings_box : cppurses::layout::Vertical {
     Settings_box();
 
-    Period_box& period_edit{this->make_child<Period_box>()};
+    Speed_box& speed_edit{this->make_child<Speed_box>()};
     Start_pause_btns& start_pause_btns{this->make_child<Start_pause_btns>()};
     Clear_step_box& clear_step_btns{this->make_child<Clear_step_box>()};
     Grid_fade& grid_fade{this->make_child<Grid_fade>()};
     Rule_edit& rule_edit{this->make_child<Rule_edit>()};
+    Engine_box& engine_box{this->make_child<Engine_box>()};
 
     sig::Signal<void(const std::string&)>& rule_change{rule_edit.rule_change};
-    sig::Signal<void(std::chrono::milliseconds)> period_set;
+    sig::Signal<void(double)>& rate_set{speed_edit.rate_set};
     sig::Signal<void()>& grid_toggled{grid_fade.grid_box.toggled};
     sig::Signal<void()>& fade_toggled{grid_fade.fade_box.toggled};
     sig::Signal<void()>& clear_request{clear_step_btns.clear_btn.clicked};
     sig::Signal<void()>& step_request{clear_step_btns.step_btn.clicked};
+    sig::Signal<void()>& tiled_selected{engine_box.tiled_selected};
+    sig::Signal<void()>& hashlife_selected{engine_box.hashlife_selected};
+    sig::Signal<void(int)>& step_exponent_set{engine_box.step_exponent_set};
 };
 }  // namespace gol
 #endif  // CPPURSES_DEMOS_GAME_OF_LIFE_SETTINGS_BOX_HPP
@@ -20,7 +20,7 @@ Generation_count::Generation_count() {
     this->cursor.disable();
 }
 
-void Generation_count::update_count(std::uint32_t count) {
+void Generation_count::update_count(std::uint64_t count) {
     count_.set_contents(std::to_string(count));
 }
 
@@ -16,7 +16,7 @@ class Generation_count : public cppurses::layout::Horizontal {
    public:
     Generation_count();
 
-    void update_count(std::uint32_t count);
+    void update_count(std::uint64_t count);
 
    private:
     cppurses::Label& title_{this->make_child<cppurses::Label>("Gen #: ")};
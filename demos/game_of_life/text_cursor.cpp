@@ -0,0 +1,97 @@
+#include "text_cursor.hpp"
+
+#include <algorithm>
+#include <cctype>
+#include <cstddef>
+#include <cstring>
+#include <limits>
+#include <string>
+
+namespace {
+bool is_digit(char c) {
+    return c >= '0' && c <= '9';
+}
+
+/// Return the digits of \p s that follow \p letter, in either case.
+std::string digits_after(const std::string& s, char letter) {
+    std::string result;
+    const auto at = s.find_first_of(
+        std::string{static_cast<char>(std::toupper(letter)),
+                    static_cast<char>(std::tolower(letter))});
+    if (at == std::string::npos) {
+        return result;
+    }
+    for (auto i = at + 1; i < s.size() && is_digit(s[i]); ++i) {
+        result.push_back(s[i]);
+    }
+    return result;
+}
+}  // namespace
+
+namespace gol {
+
+void Text_cursor::skip_line() {
+    if (this->done()) {
+        return;
+    }
+    const auto* newline = static_cast<const char*>(
+        std::memchr(at_, '\n', static_cast<std::size_t>(end_ - at_)));
+    at_ = newline == nullptr ? end_ : newline + 1;
+}
+
+void Text_cursor::skip_spaces() {
+    while (!this->done() && (*at_ == ' ' || *at_ == '\t' || *at_ == '\r')) {
+        ++at_;
+    }
+}
+
+bool Text_cursor::read_int(int& value) {
+    this->skip_spaces();
+    const char* start = at_;
+    const bool negative = this->peek() == '-';
+    if (negative || this->peek() == '+') {
+        ++at_;
+    }
+    if (!is_digit(this->peek())) {
+        at_ = start;
+        return false;
+    }
+    // Saturates instead of overflowing on absurdly long numbers.
+    long long result{0};
+    const long long limit = std::numeric_limits<int>::max();
+    while (is_digit(this->peek())) {
+        result = std::min(result * 10 + (*at_++ - '0'), limit);
+    }
+    value = static_cast<int>(negative ? -result : result);
+    return true;
+}
+
+std::string Text_cursor::read_line() {
+    const char* begin = at_;
+    this->skip_line();
+    const char* end = at_;
+    while (end != begin && (end[-1] == '\n' || end[-1] == '\r')) {
+        --end;
+    }
+    return {begin, end};
+}
+
+std::string to_rule_string(const std::string& rule) {
+    if (rule.find_first_of("Bb") != std::string::npos) {
+        return digits_after(rule, 'b') + '/' + digits_after(rule, 's');
+    }
+    const auto slash = rule.find('/');
+    if (slash == std::string::npos) {
+        return "3/23";
+    }
+    std::string survival;
+    std::string birth;
+    for (std::size_t i{0}; i < rule.size(); ++i) {
+        if (is_digit(rule[i])) {
+            (i < slash ? survival : birth).push_back(rule[i]);
+        }
+    }
+    return birth + '/' + survival;
+}
+
+}  // namespace gol
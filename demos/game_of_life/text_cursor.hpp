@@ -0,0 +1,48 @@
+#ifndef CPPURSES_DEMOS_GAME_OF_LIFE_TEXT_CURSOR_HPP
+#define CPPURSES_DEMOS_GAME_OF_LIFE_TEXT_CURSOR_HPP
+#include <string>
+
+namespace gol {
+
+/// Reads the text of a pattern file front to back, without copying it.
+class Text_cursor {
+   public:
+    Text_cursor(const char* begin, const char* end) : at_{begin}, end_{end} {}
+
+    /// Return true if every character has been read.
+    bool done() const { return at_ == end_; }
+
+    /// Return the next character without reading it, '\0' if done().
+    char peek() const { return this->done() ? '\0' : *at_; }
+
+    /// Read and return the next character, '\0' if done().
+    char get() { return this->done() ? '\0' : *at_++; }
+
+    /// Return the characters not read yet.
+    const char* position() const { return at_; }
+
+    /// Read past the end of the current line.
+    void skip_line();
+
+    /// Read past spaces, tabs and carriage returns, not past newlines.
+    void skip_spaces();
+
+    /// Read an optionally signed decimal integer into \p value.
+    /** Leading spaces are skipped. Return false, having read nothing but the
+     *  spaces, if there is no number. */
+    bool read_int(int& value);
+
+    /// Read the rest of the current line, return it without the line break.
+    std::string read_line();
+
+   private:
+    const char* at_;
+    const char* end_;
+};
+
+/// Return a "birth/survival" rule string from \p rule, as written in a file.
+/** Rules are written as "B3/S23", or as "23/3", survival counts first. */
+std::string to_rule_string(const std::string& rule);
+
+}  // namespace gol
+#endif  // CPPURSES_DEMOS_GAME_OF_LIFE_TEXT_CURSOR_HPP
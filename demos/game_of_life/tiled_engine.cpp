@@ -0,0 +1,591 @@
+#include "tiled_engine.hpp"
+
+#include <algorithm>
+#include <cstddef>
+#include <cstdint>
+#include <limits>
+#include <mutex>
+#include <utility>
+#include <vector>
+
+#include "coordinate.hpp"
+
+namespace {
+using Row = std::uint64_t;
+using Key = std::uint64_t;
+
+constexpr int length{gol::Tiled_engine::tile_length};
+
+/// Return the tile index that cell index \p v falls in, rounding down.
+int tile_of(int v) {
+    return v >= 0 ? v / length : (v + 1) / length - 1;
+}
+
+Key key_of(int tile_x, int tile_y) {
+    return (static_cast<Key>(static_cast<std::uint32_t>(tile_x)) << 32) |
+           static_cast<std::uint32_t>(tile_y);
+}
+
+int tile_x(Key key) {
+    return static_cast<std::int32_t>(static_cast<std::uint32_t>(key >> 32));
+}
+
+int tile_y(Key key) {
+    return static_cast<std::int32_t>(static_cast<std::uint32_t>(key));
+}
+
+Key neighbor(Key key, int dx, int dy) {
+    return key_of(tile_x(key) + dx, tile_y(key) + dy);
+}
+
+/// A row with each cell's west and east neighbors shifted into its place.
+struct Line {
+    Row west;
+    Row middle;
+    Row east;
+};
+
+/// Build a Line from the same row of three horizontally adjacent tiles.
+Line make_line(Row west, Row middle, Row east) {
+    return {(middle << 1) | (west >> 63), middle, (middle >> 1) | (east << 63)};
+}
+
+/// Sixty four 4 bit neighbor counts, one bit plane per binary digit.
+struct Count {
+    Row ones;
+    Row twos;
+    Row fours;
+    Row eights;
+};
+
+void half_add(Row a, Row b, Row& sum, Row& carry) {
+    sum = a ^ b;
+    carry = a & b;
+}
+
+void full_add(Row a, Row b, Row c, Row& sum, Row& carry) {
+    const Row partial = a ^ b;
+    sum = partial ^ c;
+    carry = (a & b) | (partial & c);
+}
+
+/// Add up the eight neighbors of each cell in \p middle.
+Count count_neighbors(const Line& above,
+                      const Line& middle,
+                      const Line& below) {
+    Row s0, c0, s1, c1, s2, c2;
+    full_add(above.west, above.middle, above.east, s0, c0);
+    full_add(below.west, below.middle, below.east, s1, c1);
+    half_add(middle.west, middle.east, s2, c2);
+    Count count;
+    Row twos_carry, twos_partial, fours_partial, fours_carry;
+    full_add(s0, s1, s2, count.ones, twos_carry);
+    full_add(c0, c1, c2, twos_partial, fours_partial);
+    half_add(twos_partial, twos_carry, count.twos, fours_carry);
+    half_add(fours_partial, fours_carry, count.fours, count.eights);
+    return count;
+}
+
+/// Return the cells whose neighbor count is in the set \p mask.
+Row matching(const Count& count, std::uint16_t mask) {
+    Row result{0};
+    for (int n{0}; n <= 8; ++n) {
+        if ((mask & (1 << n)) == 0) {
+            continue;
+        }
+        result |= ((n & 1) ? count.ones : ~count.ones) &
+                  ((n & 2) ? count.twos : ~count.twos) &
+                  ((n & 4) ? count.fours : ~count.fours) &
+                  ((n & 8) ? count.eights : ~count.eights);
+    }
+    return result;
+}
+
+/// Call \p visit with each tile of \p tiles within the range of tile indices.
+/** Both corners are inclusive. Each tile of a range smaller than \p tiles is
+ *  looked up, so a small range costs the same however many tiles there are. */
+template <typename Map_t, typename Function_t>
+void for_each_tile_in(const Map_t& tiles,
+                      int tx_begin,
+                      int ty_begin,
+                      int tx_end,
+                      int ty_end,
+                      const Function_t& visit) {
+    const long long range_size =
+        (static_cast<long long>(tx_end) - tx_begin + 1) *
+        (static_cast<long long>(ty_end) - ty_begin + 1);
+    if (range_size > static_cast<long long>(tiles.size())) {
+        for (const auto& key_tile : tiles) {
+            const int tx = tile_x(key_tile.first);
+            const int ty = tile_y(key_tile.first);
+            if (tx >= tx_begin && tx <= tx_end && ty >= ty_begin &&
+                ty <= ty_end) {
+                visit(tx, ty, key_tile.second);
+            }
+        }
+        return;
+    }
+    for (long long ty{ty_begin}; ty <= ty_end; ++ty) {
+        for (long long tx{tx_begin}; tx <= tx_end; ++tx) {
+            const auto at = tiles.find(
+                key_of(static_cast<int>(tx), static_cast<int>(ty)));
+            if (at != std::end(tiles)) {
+                visit(static_cast<int>(tx), static_cast<int>(ty), at->second);
+            }
+        }
+    }
+}
+
+/// Cells of a tile within a range, relative to the tile's top left.
+struct Window {
+    Row columns;
+    int y_first;
+    int y_last;
+};
+
+/// Return the cells of the tile at the origin within [top_left, bottom_right].
+/** The tile must overlap the range. Origins are 64 bit, so the tile's far edge
+ *  can't overflow at the extremes. */
+Window window_of(long long x_origin,
+                 long long y_origin,
+                 gol::Coordinate top_left,
+                 gol::Coordinate bottom_right) {
+    const int x_first =
+        static_cast<int>(std::max<long long>(0, top_left.x - x_origin));
+    const int x_last = static_cast<int>(
+        std::min<long long>(length - 1, bottom_right.x - x_origin));
+    return {(~Row{0} << x_first) & (~Row{0} >> (length - 1 - x_last)),
+            static_cast<int>(std::max<long long>(0, top_left.y - y_origin)),
+            static_cast<int>(
+                std::min<long long>(length - 1, bottom_right.y - y_origin))};
+}
+
+/// Return the age of the cell at (x, y) of \p tile.
+template <typename Tile_t>
+gol::Cell::Age_t age_of(const Tile_t& tile, int x, int y) {
+    return ((tile.age_low[y] >> x) & 1) + 2 * ((tile.age_high[y] >> x) & 1);
+}
+
+/// Advance the ages of \p survivors by one, every other cell is reset to 0.
+void age_row(Row survivors, Row& low, Row& high) {
+    const Row new_low = (~low | high) & survivors;
+    high = (high | low) & survivors;
+    low = new_low;
+}
+
+/// Return true if any of \p cells is younger than the maximum age.
+bool is_young(Row cells, Row low, Row high) {
+    return (cells & ~(low & high)) != 0;
+}
+
+/// Return the neighbors affected by changes to a tile, see add_neighbors.
+/** \p first and \p last are changes to the first and last rows, \p any is
+ *  every row's changes combined. */
+unsigned edges_of(Row first, Row last, Row any) {
+    const auto bit = [](int dx, int dy) {
+        return 1u << ((dy + 1) * 3 + dx + 1);
+    };
+    const Row west_bit{1};
+    const Row east_bit{Row{1} << 63};
+    unsigned edges{0};
+    edges |= first != 0 ? bit(0, -1) : 0;
+    edges |= last != 0 ? bit(0, 1) : 0;
+    edges |= (any & west_bit) != 0 ? bit(-1, 0) : 0;
+    edges |= (any & east_bit) != 0 ? bit(1, 0) : 0;
+    edges |= (first & west_bit) != 0 ? bit(-1, -1) : 0;
+    edges |= (first & east_bit) != 0 ? bit(1, -1) : 0;
+    edges |= (last & west_bit) != 0 ? bit(-1, 1) : 0;
+    edges |= (last & east_bit) != 0 ? bit(1, 1) : 0;
+    return edges;
+}
+
+/// Return the index of the lowest set bit of \p row, which must not be zero.
+int lowest_bit(Row row) {
+    return __builtin_ctzll(row);
+}
+}  // namespace
+
+namespace gol {
+
+constexpr int Tiled_engine::tile_length;
+constexpr std::size_t Tiled_engine::tiles_per_task;
+
+Tiled_engine::Tiled_engine(std::size_t thread_count) : pool_{thread_count} {}
+
+Tiled_engine::~Tiled_engine() {
+    this->wait();
+}
+
+void Tiled_engine::get_next_generation() {
+    if (!pending_) {
+        this->begin_generation(false);
+    }
+    this->wait();
+    this->finish_generation();
+    this->increment_generation_count();
+}
+
+void Tiled_engine::prepare_next_generation() {
+    if (!pending_) {
+        this->begin_generation(true);
+    }
+}
+
+void Tiled_engine::begin_generation(bool background) {
+    // A tile can only change if it or a neighbor changed last generation.
+    jobs_.clear();
+    for (Key key : changed_) {
+        for (int dy{-1}; dy <= 1; ++dy) {
+            for (int dx{-1}; dx <= 1; ++dx) {
+                auto at = tiles_.find(neighbor(key, dx, dy));
+                if (at != std::end(tiles_) && !at->second.queued) {
+                    at->second.queued = true;
+                    jobs_.push_back(Job{at->first, &at->second, {}});
+                }
+            }
+        }
+    }
+    // Workers only read cells and write next, the map is not touched by them.
+    for (Job& job : jobs_) {
+        for (int dy{-1}; dy <= 1; ++dy) {
+            for (int dx{-1}; dx <= 1; ++dx) {
+                const auto at = tiles_.find(neighbor(job.key, dx, dy));
+                job.around[dy + 1][dx + 1] =
+                    at == std::end(tiles_) ? nullptr : &at->second;
+            }
+        }
+    }
+    pending_ = true;
+    const auto birth = this->birth_mask();
+    const auto survival = this->survival_mask();
+    const std::size_t task_count = std::min(
+        pool_.size(), (jobs_.size() + tiles_per_task - 1) / tiles_per_task);
+    if (task_count <= 1 && !background) {
+        for (const Job& job : jobs_) {
+            compute(job, birth, survival);
+        }
+        return;
+    }
+    {
+        std::lock_guard<std::mutex> lock{mtx_};
+        tasks_left_ = task_count;
+    }
+    for (std::size_t i{0}; i < task_count; ++i) {
+        const std::size_t first = jobs_.size() * i / task_count;
+        const std::size_t last = jobs_.size() * (i + 1) / task_count;
+        pool_.submit([this, first, last, birth, survival] {
+            for (std::size_t j{first}; j < last; ++j) {
+                compute(jobs_[j], birth, survival);
+            }
+            std::lock_guard<std::mutex> lock{mtx_};
+            if (--tasks_left_ == 0) {
+                tasks_done_.notify_all();
+            }
+        });
+    }
+}
+
+void Tiled_engine::wait() {
+    std::unique_lock<std::mutex> lock{mtx_};
+    tasks_done_.wait(lock, [this] { return tasks_left_ == 0; });
+}
+
+void Tiled_engine::discard_generation() {
+    changes_known_ = false;
+    if (!pending_) {
+        return;
+    }
+    this->wait();
+    for (Job& job : jobs_) {
+        job.tile->queued = false;
+    }
+    jobs_.clear();
+    pending_ = false;
+}
+
+void Tiled_engine::finish_generation() {
+    std::vector<Key> changed;
+    std::vector<Key> aging;
+    std::vector<Key> delta_tiles;
+    std::vector<std::pair<Key, unsigned>> edges;
+    for (Key key : delta_tiles_) {
+        auto at = tiles_.find(key);
+        if (at != std::end(tiles_)) {
+            at->second.delta.fill(0);
+        }
+    }
+    // Neighbors are read from cells, so no tile is advanced until all are done.
+    for (const Job& job : jobs_) {
+        Tile& tile = *job.tile;
+        Row first{0}, last{0}, any{0}, any_delta{0};
+        tile.aging = false;
+        for (int y{0}; y < length; ++y) {
+            const Row changes = tile.cells[y] ^ tile.next[y];
+            const Row survivors = tile.cells[y] & tile.next[y];
+            tile.delta[y] =
+                changes | (survivors & ~(tile.age_low[y] & tile.age_high[y]));
+            any_delta |= tile.delta[y];
+            age_row(survivors, tile.age_low[y], tile.age_high[y]);
+            tile.cells[y] = tile.next[y];
+            tile.aging = tile.aging || is_young(tile.cells[y], tile.age_low[y],
+                                                tile.age_high[y]);
+            any |= changes;
+            first = y == 0 ? changes : first;
+            last = y == length - 1 ? changes : last;
+        }
+        tile.changed = any != 0;
+        if (tile.changed) {
+            changed.push_back(job.key);
+            edges.emplace_back(job.key, edges_of(first, last, any));
+        }
+        if (any_delta != 0) {
+            delta_tiles.push_back(job.key);
+        }
+        if (tile.aging) {
+            aging.push_back(job.key);
+        }
+    }
+    // Tiles with young cells age even when their cells are stable.
+    for (Key key : aging_) {
+        auto at = tiles_.find(key);
+        if (at == std::end(tiles_) || at->second.queued) {
+            continue;
+        }
+        Tile& tile = at->second;
+        tile.aging = false;
+        for (int y{0}; y < length; ++y) {
+            tile.delta[y] =
+                tile.cells[y] & ~(tile.age_low[y] & tile.age_high[y]);
+            age_row(tile.cells[y], tile.age_low[y], tile.age_high[y]);
+            tile.aging = tile.aging || is_young(tile.cells[y], tile.age_low[y],
+                                                tile.age_high[y]);
+        }
+        // Young cells were found last generation, so some have aged.
+        delta_tiles.push_back(key);
+        if (tile.aging) {
+            aging.push_back(key);
+        }
+    }
+    for (const Job& job : jobs_) {
+        Tile& tile = *job.tile;
+        tile.queued = false;
+        const bool empty =
+            std::none_of(std::begin(tile.cells), std::end(tile.cells),
+                         [](Row row) { return row != 0; });
+        if (empty && !tile.changed) {
+            tiles_.erase(job.key);
+        }
+    }
+    // After erasing, or these new, empty tiles would be dropped immediately.
+    for (const auto& key_edges : edges) {
+        this->add_neighbors(key_edges.first, key_edges.second);
+    }
+    jobs_.clear();
+    pending_ = false;
+    changed_ = std::move(changed);
+    aging_ = std::move(aging);
+    delta_tiles_ = std::move(delta_tiles);
+    changes_known_ = true;
+}
+
+void Tiled_engine::give_life(Coordinate position) {
+    this->discard_generation();
+    if (this->set_cell(position, true)) {
+        this->reset_generation_count();
+    }
+}
+
+void Tiled_engine::kill(Coordinate position) {
+    this->discard_generation();
+    if (this->set_cell(position, false)) {
+        this->reset_generation_count();
+    }
+}
+
+void Tiled_engine::kill_all() {
+    this->discard_generation();
+    tiles_.clear();
+    changed_.clear();
+    aging_.clear();
+    delta_tiles_.clear();
+    this->reset_generation_count();
+}
+
+bool Tiled_engine::alive_at(Coordinate position) const {
+    const int tx = tile_of(position.x);
+    const int ty = tile_of(position.y);
+    const auto at = tiles_.find(key_of(tx, ty));
+    if (at == std::end(tiles_)) {
+        return false;
+    }
+    const int x = position.x - tx * length;
+    const int y = position.y - ty * length;
+    return (at->second.cells[y] >> x) & 1;
+}
+
+void Tiled_engine::import(const Run_source& source) {
+    this->discard_generation();
+    source([this](Run run) {
+        // Each tile the run crosses is given a mask of its part of the run.
+        const int ty = tile_of(run.position.y);
+        const int y = run.position.y - ty * length;
+        long long x = run.position.x;
+        const long long x_end = std::min(
+            x + std::max(run.length, 0),
+            static_cast<long long>(std::numeric_limits<int>::max()) + 1);
+        while (x < x_end) {
+            const int tx = tile_of(static_cast<int>(x));
+            const long long x_origin = static_cast<long long>(tx) * length;
+            const int first = static_cast<int>(x - x_origin);
+            const int last = static_cast<int>(
+                std::min<long long>(length, x_end - x_origin)) - 1;
+            const Row cells =
+                (~Row{0} << first) & (~Row{0} >> (length - 1 - last));
+            this->set_cells(key_of(tx, ty), y, cells, true);
+            x = x_origin + length;
+        }
+    });
+    this->reset_generation_count();
+}
+
+void Tiled_engine::for_each_alive_in(Coordinate top_left,
+                                     Coordinate bottom_right,
+                                     const Visitor& visit) const {
+    const auto visit_tile = [&](int tx, int ty, const Tile& tile) {
+        const long long x_origin = static_cast<long long>(tx) * length;
+        const long long y_origin = static_cast<long long>(ty) * length;
+        const Window w = window_of(x_origin, y_origin, top_left, bottom_right);
+        for (int y{w.y_first}; y <= w.y_last; ++y) {
+            Row row = tile.cells[y] & w.columns;
+            while (row != 0) {
+                const int x = lowest_bit(row);
+                visit({static_cast<int>(x_origin + x),
+                       static_cast<int>(y_origin + y)},
+                      age_of(tile, x, y));
+                row &= row - 1;
+            }
+        }
+    };
+    for_each_tile_in(tiles_, tile_of(top_left.x), tile_of(top_left.y),
+                     tile_of(bottom_right.x), tile_of(bottom_right.y),
+                     visit_tile);
+}
+
+bool Tiled_engine::for_each_change_in(Coordinate top_left,
+                                      Coordinate bottom_right,
+                                      const Visitor& changed,
+                                      const Death_visitor& died) const {
+    if (!changes_known_) {
+        return false;
+    }
+    const int tx_begin = tile_of(top_left.x);
+    const int tx_end = tile_of(bottom_right.x);
+    const int ty_begin = tile_of(top_left.y);
+    const int ty_end = tile_of(bottom_right.y);
+    for (Key key : delta_tiles_) {
+        const int tx = tile_x(key);
+        const int ty = tile_y(key);
+        if (tx < tx_begin || tx > tx_end || ty < ty_begin || ty > ty_end) {
+            continue;
+        }
+        const Tile& tile = tiles_.at(key);
+        const long long x_origin = static_cast<long long>(tx) * length;
+        const long long y_origin = static_cast<long long>(ty) * length;
+        const Window w = window_of(x_origin, y_origin, top_left, bottom_right);
+        for (int y{w.y_first}; y <= w.y_last; ++y) {
+            Row row = tile.delta[y] & w.columns;
+            while (row != 0) {
+                const int x = lowest_bit(row);
+                const Coordinate position{static_cast<int>(x_origin + x),
+                                          static_cast<int>(y_origin + y)};
+                if ((tile.cells[y] >> x) & 1) {
+                    changed(position, age_of(tile, x, y));
+                } else {
+                    died(position);
+                }
+                row &= row - 1;
+            }
+        }
+    }
+    return true;
+}
+
+void Tiled_engine::compute(const Job& job,
+                           std::uint16_t birth,
+                           std::uint16_t survival) {
+    const auto& around = job.around;
+    // Row y of the three tiles in this tile's row, -1 and 64 reach above/below.
+    const auto line_at = [&around](int y) {
+        int band{1};
+        if (y < 0) {
+            band = 0;
+            y = length - 1;
+        } else if (y >= length) {
+            band = 2;
+            y = 0;
+        }
+        const auto row = [&](int column) -> Row {
+            const Tile* t = around[band][column];
+            return t == nullptr ? 0 : t->cells[y];
+        };
+        return make_line(row(0), row(1), row(2));
+    };
+    Line above = line_at(-1);
+    Line middle = line_at(0);
+    for (int y{0}; y < length; ++y) {
+        const Line below = line_at(y + 1);
+        const Count count = count_neighbors(above, middle, below);
+        job.tile->next[y] = (middle.middle & matching(count, survival)) |
+                            (~middle.middle & matching(count, birth));
+        above = middle;
+        middle = below;
+    }
+}
+
+void Tiled_engine::add_neighbors(Key key, unsigned edges) {
+    for (int dy{-1}; dy <= 1; ++dy) {
+        for (int dx{-1}; dx <= 1; ++dx) {
+            if ((edges & (1u << ((dy + 1) * 3 + dx + 1))) != 0) {
+                tiles_[neighbor(key, dx, dy)];
+            }
+        }
+    }
+}
+
+bool Tiled_engine::set_cell(Coordinate position, bool alive) {
+    const int tx = tile_of(position.x);
+    const int ty = tile_of(position.y);
+    const int x = position.x - tx * length;
+    const int y = position.y - ty * length;
+    return this->set_cells(key_of(tx, ty), y, Row{1} << x, alive) != 0;
+}
+
+Tiled_engine::Row Tiled_engine::set_cells(Key key,
+                                          int y,
+                                          Row cells,
+                                          bool alive) {
+    if (!alive && tiles_.count(key) == 0) {
+        return 0;
+    }
+    Tile& tile = tiles_[key];
+    const Row changes = (alive ? ~tile.cells[y] : tile.cells[y]) & cells;
+    if (changes == 0) {
+        return 0;
+    }
+    tile.cells[y] ^= changes;
+    tile.age_low[y] &= ~changes;
+    tile.age_high[y] &= ~changes;
+    if (!tile.changed) {
+        tile.changed = true;
+        changed_.push_back(key);
+    }
+    if (alive && !tile.aging) {
+        tile.aging = true;
+        aging_.push_back(key);
+    }
+    this->add_neighbors(key, edges_of(y == 0 ? changes : 0,
+                                      y == length - 1 ? changes : 0, changes));
+    return changes;
+}
+
+}  // namespace gol
@@ -0,0 +1,143 @@
+#ifndef CPPURSES_DEMOS_GAME_OF_LIFE_TILED_ENGINE_HPP
+#define CPPURSES_DEMOS_GAME_OF_LIFE_TILED_ENGINE_HPP
+#include <array>
+#include <condition_variable>
+#include <cstddef>
+#include <cstdint>
+#include <mutex>
+#include <unordered_map>
+#include <vector>
+
+#include <cppurses/system/thread_pool.hpp>
+
+#include "coordinate.hpp"
+#include "engine.hpp"
+
+namespace gol {
+
+/// Engine that stores cells as bits, in 64x64 tiles of 64 bit rows.
+/** A generation is computed a whole row at a time, neighbor counts are added
+ *  up with bitwise adders, so 64 cells are updated in a handful of
+ *  instructions. Only tiles that changed in the last generation, and their
+ *  neighbors, are computed. Tiles are created when cells are born on their
+ *  edge and dropped when they are empty and stable. Ages are tracked up to 3
+ *  generations, after that a Cell is reported as 3 generations old.
+ *
+ *  Tiles are computed in parallel on a Thread_pool. Each tile is computed into
+ *  a second buffer, so the current generation can be read while the next one
+ *  is computed in the background, see prepare_next_generation(). */
+class Tiled_engine : public Engine {
+   public:
+    /// Width and height of a tile, in cells.
+    static constexpr int tile_length{64};
+
+    /// Compute generations on \p thread_count worker threads.
+    explicit Tiled_engine(std::size_t thread_count =
+                              cppurses::Thread_pool::default_thread_count());
+
+    /// Wait for the workers to finish with any generation in progress.
+    ~Tiled_engine();
+
+    void get_next_generation() override;
+    void prepare_next_generation() override;
+    void give_life(Coordinate position) override;
+    void kill(Coordinate position) override;
+    void kill_all() override;
+    bool alive_at(Coordinate position) const override;
+    void import(const Run_source& source) override;
+    using Engine::import;
+    void for_each_alive_in(Coordinate top_left,
+                           Coordinate bottom_right,
+                           const Visitor& visit) const override;
+    bool for_each_change_in(Coordinate top_left,
+                            Coordinate bottom_right,
+                            const Visitor& changed,
+                            const Death_visitor& died) const override;
+
+    /// Return the number of tiles currently allocated.
+    std::size_t tile_count() const { return tiles_.size(); }
+
+   private:
+    using Row = std::uint64_t;
+    using Rows = std::array<Row, tile_length>;
+    /// Tile coordinates packed into one integer, x in the high half.
+    using Key = std::uint64_t;
+
+    /// Bit x of cells[y] is the cell at (x, y) from the tile's top left.
+    struct Tile {
+        Rows cells;
+        Rows next;
+        /// Two bit saturating age of each cell, low and high bits.
+        Rows age_low;
+        Rows age_high;
+        /// Cells born, died or aged in the last generation.
+        Rows delta;
+        /// Cells changed in the last generation, neighbors must be computed.
+        bool changed;
+        /// Some cells are younger than the maximum tracked age.
+        bool aging;
+        /// In the set of tiles computed for the current generation.
+        bool queued;
+    };
+
+    /// A tile to compute, neighbors are found before handing it to a worker.
+    struct Job {
+        Key key;
+        Tile* tile;
+        /// around[1][1] is tile, missing neighbors are nullptr, all dead.
+        const Tile* around[3][3];
+    };
+
+    /// Fewest tiles worth handing to a worker thread as one task.
+    static constexpr std::size_t tiles_per_task{8};
+
+    std::unordered_map<Key, Tile> tiles_;
+    std::vector<Key> changed_;
+    std::vector<Key> aging_;
+    // Tiles with a delta, valid if no cell was edited since the last step.
+    std::vector<Key> delta_tiles_;
+    bool changes_known_{false};
+
+    // Generation being computed, jobs_ is only modified when no tasks remain.
+    std::vector<Job> jobs_;
+    bool pending_{false};
+    std::mutex mtx_;
+    std::condition_variable tasks_done_;
+    std::size_t tasks_left_{0};
+
+    cppurses::Thread_pool pool_;
+
+    /// Find the tiles that can change and start computing their next cells.
+    /** Small generations are computed on this thread unless \p background. */
+    void begin_generation(bool background);
+
+    /// Block until every task of the generation being computed has finished.
+    void wait();
+
+    /// Throw away the generation being computed, before editing the cells.
+    /** The changes of the last generation are no longer known after that. */
+    void discard_generation();
+
+    /// Move each computed tile to its next cells, update ages and tile set.
+    void finish_generation();
+
+    /// Compute the next cells of job.tile from its cells and its neighbors'.
+    static void compute(const Job& job,
+                        std::uint16_t birth,
+                        std::uint16_t survival);
+
+    /// Create each neighbor of the tile at \p key flagged in \p edges.
+    /** Bit (dy + 1) * 3 + (dx + 1) of \p edges is the neighbor at (dx, dy). */
+    void add_neighbors(Key key, unsigned edges);
+
+    /// Set the cell at \p position to \p alive, with an age of zero.
+    /** Returns false if the cell was already in that state. */
+    bool set_cell(Coordinate position, bool alive);
+
+    /// Set \p cells of row \p y of the tile at \p key to \p alive.
+    /** Cells that change are given an age of zero, they are returned. */
+    Row set_cells(Key key, int y, Row cells, bool alive);
+};
+
+}  // namespace gol
+#endif  // CPPURSES_DEMOS_GAME_OF_LIFE_TILED_ENGINE_HPP
@@ -0,0 +1,76 @@
+#include "canvas.hpp"
+
+#include <algorithm>
+#include <cstddef>
+
+#include <cppurses/painter/glyph.hpp>
+#include <cppurses/widget/point.hpp>
+
+using namespace cppurses;
+
+namespace demos {
+namespace glyph_paint {
+
+constexpr std::size_t Canvas::chunk_length;
+
+const Glyph* Canvas::at(Point p) const {
+    const auto iter = chunks_.find(key_of(p));
+    if (iter == std::end(chunks_)) {
+        return nullptr;
+    }
+    const std::size_t x{p.x % chunk_length};
+    const std::size_t y{p.y % chunk_length};
+    if ((iter->second.rows[y] & (Row{1} << x)) == 0) {
+        return nullptr;
+    }
+    return &iter->second.glyphs[y * chunk_length + x];
+}
+
+void Canvas::set(Point p, const Glyph& glyph) {
+    Chunk& chunk{chunks_[key_of(p)]};
+    const std::size_t x{p.x % chunk_length};
+    const std::size_t y{p.y % chunk_length};
+    if ((chunk.rows[y] & (Row{1} << x)) == 0) {
+        chunk.rows[y] |= Row{1} << x;
+        ++chunk.count;
+    }
+    chunk.glyphs[y * chunk_length + x] = glyph;
+}
+
+void Canvas::set_row(Point p, std::size_t length, const Glyph& glyph) {
+    const std::size_t y{p.y % chunk_length};
+    while (length != 0) {
+        Chunk& chunk{chunks_[key_of(p)]};
+        const std::size_t x{p.x % chunk_length};
+        const std::size_t n{std::min(length, chunk_length - x)};
+        const Row bits{n == chunk_length ? ~Row{0}
+                                         : ((Row{1} << n) - 1) << x};
+        chunk.count += __builtin_popcount(bits & ~chunk.rows[y]);
+        chunk.rows[y] |= bits;
+        std::fill_n(chunk.glyphs.begin() + y * chunk_length + x, n, glyph);
+        p.x += n;
+        length -= n;
+    }
+}
+
+bool Canvas::erase(Point p) {
+    const auto iter = chunks_.find(key_of(p));
+    if (iter == std::end(chunks_)) {
+        return false;
+    }
+    Chunk& chunk{iter->second};
+    const std::size_t x{p.x % chunk_length};
+    const std::size_t y{p.y % chunk_length};
+    if ((chunk.rows[y] & (Row{1} << x)) == 0) {
+        return false;
+    }
+    chunk.rows[y] &= ~(Row{1} << x);
+    chunk.glyphs[y * chunk_length + x] = Glyph{};
+    if (--chunk.count == 0) {
+        chunks_.erase(iter);
+    }
+    return true;
+}
+
+}  // namespace glyph_paint
+}  // namespace demos
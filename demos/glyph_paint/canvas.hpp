@@ -0,0 +1,157 @@
+#ifndef DEMOS_GLYPH_PAINT_CANVAS_HPP
+#define DEMOS_GLYPH_PAINT_CANVAS_HPP
+#include <algorithm>
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <map>
+#include <utility>
+
+#include <cppurses/painter/glyph.hpp>
+#include <cppurses/widget/area.hpp>
+#include <cppurses/widget/point.hpp>
+
+namespace demos {
+namespace glyph_paint {
+
+/// Sparse storage for the Glyphs of a drawing, in dense square chunks.
+/** Only chunks with at least one painted Glyph are allocated. Chunks are kept
+ *  in row-major order, so a visible area or the whole drawing can be walked
+ *  without hashing each cell, and without sorting. */
+class Canvas {
+   public:
+    /// Width and height of a chunk, in cells.
+    static constexpr std::size_t chunk_length{32};
+
+    /// Return the Glyph painted at \p p, or nullptr if there is none.
+    const cppurses::Glyph* at(cppurses::Point p) const;
+
+    /// Paint \p glyph at \p p, replacing any Glyph already there.
+    void set(cppurses::Point p, const cppurses::Glyph& glyph);
+
+    /// Paint \p glyph on \p length cells of a row, from \p p to the right.
+    void set_row(cppurses::Point p,
+                 std::size_t length,
+                 const cppurses::Glyph& glyph);
+
+    /// Remove the Glyph at \p p, return false if there was none.
+    bool erase(cppurses::Point p);
+
+    /// Remove every Glyph.
+    void clear() { chunks_.clear(); }
+
+    /// Return true if no Glyphs are painted.
+    bool empty() const { return chunks_.empty(); }
+
+    /// Call visit(Point, const Glyph&) for each Glyph within the given area.
+    /** Only the chunks overlapping the area are looked at, Glyphs are visited
+     *  one chunk at a time. */
+    template <typename Function>
+    void for_each_in(cppurses::Point top_left,
+                     cppurses::Area size,
+                     Function&& visit) const;
+
+    /// Call visit(Point, const Glyph&) for each Glyph, in row-major order.
+    template <typename Function>
+    void for_each(Function&& visit) const;
+
+   private:
+    using Row = std::uint32_t;
+
+    struct Chunk {
+        std::array<cppurses::Glyph, chunk_length * chunk_length> glyphs;
+        /// Bit x of rows[y] is set if a Glyph is painted at (x, y).
+        std::array<Row, chunk_length> rows{};
+        std::size_t count{0};
+    };
+
+    /// Chunk index, y first so that std::map keeps row-major order.
+    using Key = std::pair<std::size_t, std::size_t>;
+
+    std::map<Key, Chunk> chunks_;
+
+    static Key key_of(cppurses::Point p) {
+        return {p.y / chunk_length, p.x / chunk_length};
+    }
+
+    /// Call visit for each Glyph of \p chunk row \p y, with x in [first, end).
+    template <typename Function>
+    static void visit_row(const Key& key,
+                          const Chunk& chunk,
+                          std::size_t y,
+                          std::size_t first,
+                          std::size_t end,
+                          Function& visit);
+};
+
+template <typename Function>
+void Canvas::visit_row(const Key& key,
+                       const Chunk& chunk,
+                       std::size_t y,
+                       std::size_t first,
+                       std::size_t end,
+                       Function& visit) {
+    const std::size_t left{key.second * chunk_length};
+    Row row{chunk.rows[y]};
+    if (first > left) {
+        row &= ~Row{0} << (first - left);
+    }
+    if (end < left + chunk_length) {
+        row &= (Row{1} << (end - left)) - 1;
+    }
+    while (row != 0) {
+        const std::size_t x = __builtin_ctz(row);
+        row &= row - 1;
+        visit(cppurses::Point{left + x, key.first * chunk_length + y},
+              chunk.glyphs[y * chunk_length + x]);
+    }
+}
+
+template <typename Function>
+void Canvas::for_each_in(cppurses::Point top_left,
+                         cppurses::Area size,
+                         Function&& visit) const {
+    if (size.width == 0 || size.height == 0) {
+        return;
+    }
+    const std::size_t x_end{top_left.x + size.width};
+    const std::size_t y_end{top_left.y + size.height};
+    const std::size_t first_x{top_left.x / chunk_length};
+    const std::size_t last_x{(x_end - 1) / chunk_length};
+    const std::size_t last_y{(y_end - 1) / chunk_length};
+    for (std::size_t cy{top_left.y / chunk_length}; cy <= last_y; ++cy) {
+        const std::size_t top{cy * chunk_length};
+        const std::size_t y_first{top_left.y > top ? top_left.y - top : 0};
+        const std::size_t y_limit{std::min(chunk_length, y_end - top)};
+        const auto end = chunks_.upper_bound(Key{cy, last_x});
+        for (auto it = chunks_.lower_bound(Key{cy, first_x}); it != end;
+             ++it) {
+            for (std::size_t y{y_first}; y < y_limit; ++y) {
+                visit_row(it->first, it->second, y, top_left.x, x_end, visit);
+            }
+        }
+    }
+}
+
+template <typename Function>
+void Canvas::for_each(Function&& visit) const {
+    const std::size_t no_limit{static_cast<std::size_t>(-1)};
+    auto band = std::begin(chunks_);
+    while (band != std::end(chunks_)) {
+        auto band_end = band;
+        while (band_end != std::end(chunks_) &&
+               band_end->first.first == band->first.first) {
+            ++band_end;
+        }
+        for (std::size_t y{0}; y < chunk_length; ++y) {
+            for (auto it = band; it != band_end; ++it) {
+                visit_row(it->first, it->second, y, 0, no_limit, visit);
+            }
+        }
+        band = band_end;
+    }
+}
+
+}  // namespace glyph_paint
+}  // namespace demos
+#endif  // DEMOS_GLYPH_PAINT_CANVAS_HPP
@@ -0,0 +1,52 @@
+#include "canvas_edit.hpp"
+
+#include <algorithm>
+
+#include <cppurses/painter/glyph.hpp>
+#include <cppurses/widget/point.hpp>
+
+#include "canvas.hpp"
+
+using namespace cppurses;
+
+namespace demos {
+namespace glyph_paint {
+
+void Canvas_edit::remember(const Canvas& canvas, Point p) {
+    const Glyph* previous{canvas.at(p)};
+    cells_.push_back(Cell{p, previous == nullptr ? Glyph{} : *previous,
+                          previous != nullptr});
+    if (cells_.size() == 1) {
+        top_left_ = p;
+        bottom_right_ = p;
+        return;
+    }
+    top_left_.x = std::min(top_left_.x, p.x);
+    top_left_.y = std::min(top_left_.y, p.y);
+    bottom_right_.x = std::max(bottom_right_.x, p.x);
+    bottom_right_.y = std::max(bottom_right_.y, p.y);
+}
+
+void Canvas_edit::undo(Canvas& canvas) const {
+    // In reverse, a cell remembered twice ends with its first contents.
+    for (auto iter = cells_.rbegin(); iter != cells_.rend(); ++iter) {
+        if (iter->painted) {
+            canvas.set(iter->position, iter->glyph);
+        } else {
+            canvas.erase(iter->position);
+        }
+    }
+}
+
+void Canvas_edit::redo(Canvas& canvas) const {
+    for (const Cell& cell : cells_) {
+        if (erases_) {
+            canvas.erase(cell.position);
+        } else {
+            canvas.set(cell.position, glyph_);
+        }
+    }
+}
+
+}  // namespace glyph_paint
+}  // namespace demos
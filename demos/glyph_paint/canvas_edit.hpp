@@ -0,0 +1,65 @@
+#ifndef DEMOS_GLYPH_PAINT_CANVAS_EDIT_HPP
+#define DEMOS_GLYPH_PAINT_CANVAS_EDIT_HPP
+#include <cstddef>
+#include <vector>
+
+#include <cppurses/painter/glyph.hpp>
+#include <cppurses/widget/point.hpp>
+
+#include "canvas.hpp"
+
+namespace demos {
+namespace glyph_paint {
+
+/// A single change to a Canvas, stored as a delta for undo and redo.
+/** Every changed cell was set to the same Glyph, or erased, so only each
+ *  cell's previous contents are kept. */
+class Canvas_edit {
+   public:
+    /// Start an edit that paints \p glyph, or erases if \p erases is true.
+    Canvas_edit(const cppurses::Glyph& glyph, bool erases)
+        : glyph_{glyph}, erases_{erases} {}
+
+    /// Save the contents of \p canvas at \p p before this edit changes it.
+    void remember(const Canvas& canvas, cppurses::Point p);
+
+    /// Return true if no cells have been remembered.
+    bool empty() const { return cells_.empty(); }
+
+    /// Return the cells within this edit to what they were before it.
+    void undo(Canvas& canvas) const;
+
+    /// Apply this edit again to each remembered cell.
+    void redo(Canvas& canvas) const;
+
+    /// Return the top left corner of the changed cells.
+    cppurses::Point top_left() const { return top_left_; }
+
+    /// Return the bottom right corner of the changed cells, inclusive.
+    cppurses::Point bottom_right() const { return bottom_right_; }
+
+    /// Return the memory used by this edit.
+    std::size_t bytes() const {
+        return sizeof(Canvas_edit) + cells_.capacity() * sizeof(Cell);
+    }
+
+    /// Edits are never merged, each tool use is undone on its own.
+    bool merge(const Canvas_edit&) { return false; }
+
+   private:
+    struct Cell {
+        cppurses::Point position;
+        cppurses::Glyph glyph;
+        bool painted;
+    };
+
+    std::vector<Cell> cells_;
+    cppurses::Glyph glyph_;
+    bool erases_;
+    cppurses::Point top_left_;
+    cppurses::Point bottom_right_;
+};
+
+}  // namespace glyph_paint
+}  // namespace demos
+#endif  // DEMOS_GLYPH_PAINT_CANVAS_EDIT_HPP
@@ -1,5 +1,7 @@
 #include "glyph_paint.hpp"
 
+#include <fstream>
+
 #include <cppurses/widget/widget_slots.hpp>
 
 using namespace cppurses;
@@ -41,6 +43,16 @@ Glyph_paint::Glyph_paint() {
     side_pane.attribute_box.underline_box.unchecked.connect(
         slot::remove_attribute(paint_area, Attribute::Underline));
 
+    auto& tool_box = side_pane.options_box.options_a.tool_box;
+    tool_box.add_option("Brush Tool")
+        .connect(slot::set_tool(paint_area, Paint_area::Tool::Brush));
+    tool_box.add_option("Fill Tool")
+        .connect(slot::set_tool(paint_area, Paint_area::Tool::Fill));
+    tool_box.add_option("Rectangle Tool")
+        .connect(slot::set_tool(paint_area, Paint_area::Tool::Rectangle));
+    tool_box.add_option("Line Tool")
+        .connect(slot::set_tool(paint_area, Paint_area::Tool::Line));
+
     paint_area.glyph_changed.connect(
         cppurses::slot::update_status(side_pane.show_glyph));
     side_pane.options_box.options_a.clone_btn.clicked.connect(
@@ -67,8 +79,10 @@ Glyph_paint::Glyph_paint() {
         slot::disable_grid(paint_area));
     side_pane.options_box.options_b.save_file.save_requested.connect(
         slot::write(paint_area));
-    side_pane.options_box.options_b.open_file.open_requested.connect(
-        slot::read(paint_area));
+    auto& open_file = side_pane.options_box.options_b.open_file;
+    open_file.open_requested.connect([this, &open_file](std::ifstream&) {
+        paint_area.load(open_file.filename_edit.contents().str());
+    });
 }
 
 }  // namespace glyph_paint
@@ -12,6 +12,9 @@ namespace demos {
 namespace glyph_paint {
 
 Options_A::Options_A() {
+    tool_box.brush.set_background(Color::White);
+    tool_box.brush.set_foreground(Color::Black);
+
     clone_btn.brush.set_background(Color::White);
     clone_btn.brush.set_foreground(Color::Black);
 
@@ -42,7 +45,7 @@ Options_B::Options_B() {
 
 Options_stack::Options_stack() {
     this->set_active_page(0);
-    this->height_policy.fixed(6);
+    this->height_policy.fixed(7);
 
     options_a.more_btn.clicked.connect(
         cppurses::slot::set_active_page(*this, 1));
@@ -17,6 +17,7 @@ namespace glyph_paint {
 struct Options_A : public cppurses::layout::Vertical {
     Options_A();
 
+    cppurses::Cycle_box& tool_box{this->make_child<cppurses::Cycle_box>()};
     cppurses::Push_button& clone_btn{
         this->make_child<cppurses::Push_button>("Clone Tool")};
     cppurses::Checkbox& eraser_box{
@@ -1,5 +1,6 @@
 #include "paint_area.hpp"
 
+#include <algorithm>
 #include <cctype>
 #include <codecvt>
 #include <cstddef>
@@ -7,17 +8,22 @@
 #include <iostream>
 #include <iterator>
 #include <locale>
+#include <stdexcept>
 #include <string>
 #include <utility>
+#include <vector>
 
 #include <cppurses/painter/attribute.hpp>
 #include <cppurses/painter/brush.hpp>
 #include <cppurses/painter/color.hpp>
 #include <cppurses/painter/glyph.hpp>
+#include <cppurses/painter/glyph_file.hpp>
 #include <cppurses/painter/glyph_string.hpp>
 #include <cppurses/painter/painter.hpp>
 #include <cppurses/system/events/key.hpp>
 #include <cppurses/system/events/mouse.hpp>
+#include <cppurses/system/mapped_file.hpp>
+#include <cppurses/widget/area.hpp>
 #include <cppurses/widget/border.hpp>
 #include <cppurses/widget/focus_policy.hpp>
 #include <cppurses/widget/point.hpp>
@@ -26,32 +32,16 @@
 #include <optional/optional.hpp>
 #include <signals/slot.hpp>
 
-using namespace cppurses;
-
-namespace {
-
-void insert_newline(Point first, Point second, std::ostream& os) {
-    if (first.y >= second.y) {
-        return;
-    }
-    std::string newlines(second.y - first.y, '\n');
-    os << newlines;
-}
-
-void insert_space(Point first, Point second, std::ostream& os) {
-    std::size_t spaces_n{second.x};
-    if (first.y == second.y) {
-        spaces_n -= first.x + 1;
-    }
-    std::string spaces(spaces_n, ' ');
-    os << spaces;
-}
+#include "canvas.hpp"
+#include "canvas_edit.hpp"
 
-}  // namespace
+using namespace cppurses;
 
 namespace demos {
 namespace glyph_paint {
 
+constexpr std::size_t Paint_area::max_canvas_length;
+
 Paint_area::Paint_area() {
     this->focus_policy = Focus_policy::Strong;
 
@@ -60,6 +50,11 @@ Paint_area::Paint_area() {
     this->border.segments.east.enable();
 }
 
+void Paint_area::set_tool(Tool tool) {
+    tool_ = tool;
+    anchor_ = opt::none;
+}
+
 void Paint_area::set_glyph(Glyph glyph) {
     current_glyph_ = std::move(glyph);
     glyph_changed(current_glyph_);
@@ -126,17 +121,39 @@ void Paint_area::disable_erase() {
 
 void Paint_area::enable_grid() {
     this->wallpaper = Glyph{L'┼', foreground(Color::Dark_gray)};
-    this->update();
+    this->repaint();
 }
 
 void Paint_area::disable_grid() {
     this->wallpaper = L' ';
-    this->update();
+    this->repaint();
 }
 
 void Paint_area::clear() {
-    glyphs_painted_.clear();
-    this->update();
+    Canvas_edit edit{Glyph{}, true};
+    canvas_.for_each(
+        [this, &edit](Point p, const Glyph&) { edit.remember(canvas_, p); });
+    canvas_.clear();
+    if (!edit.empty()) {
+        history_.push(std::move(edit));
+    }
+    this->repaint();
+}
+
+void Paint_area::undo() {
+    if (history_.can_undo()) {
+        const Canvas_edit& edit{history_.undo()};
+        edit.undo(canvas_);
+        this->damage(edit.top_left(), edit.bottom_right());
+    }
+}
+
+void Paint_area::redo() {
+    if (history_.can_redo()) {
+        const Canvas_edit& edit{history_.redo()};
+        edit.redo(canvas_);
+        this->damage(edit.top_left(), edit.bottom_right());
+    }
 }
 
 Glyph Paint_area::glyph() const {
@@ -148,45 +165,89 @@ void Paint_area::toggle_clone() {
 }
 
 void Paint_area::write(std::ostream& os) {
-    Point previous_nl{0, 0};
-    Point previous_s{0, static_cast<std::size_t>(-1)};
-    for (const auto& cg_pair : glyphs_painted_) {
-        insert_newline(previous_nl, cg_pair.first, os);
-        insert_space(previous_s, cg_pair.first, os);
-        os << cppurses::utility::wchar_to_bytes(cg_pair.second.symbol);
-        previous_nl = cg_pair.first;
-        previous_s = cg_pair.first;
-    }
+    Point bottom_right{0, 0};
+    canvas_.for_each([&bottom_right](Point p, const Glyph&) {
+        bottom_right.x = std::max(bottom_right.x, p.x + 1);
+        bottom_right.y = p.y + 1;
+    });
+    Glyph_file_writer writer{bottom_right.x, bottom_right.y};
+    std::size_t next{0};  // Index of the next cell to be appended.
+    canvas_.for_each([&writer, &next, &bottom_right](Point p,
+                                                     const Glyph& glyph) {
+        const std::size_t index{p.y * bottom_right.x + p.x};
+        writer.skip(index - next);
+        writer.append(glyph);
+        next = index + 1;
+    });
+    writer.write(os);
 }
 
 void Paint_area::read(std::istream& is) {
-    this->clear();
-    Point current{0, 0};
-    is >> std::noskipws;
-    std::string file_text{std::istream_iterator<char>{is},
-                          std::istream_iterator<char>()};
-    Glyph_string file_glyphs{file_text};
-    for (const Glyph& glyph : file_glyphs) {
-        const wchar_t sym{glyph.symbol};
-        if (sym != L' ' && sym != L'\n' && sym != L'\r') {
-            glyphs_painted_[current] = glyph;
+    const std::string contents{std::istreambuf_iterator<char>{is},
+                               std::istreambuf_iterator<char>{}};
+    this->read(contents.data(), contents.data() + contents.size());
+}
+
+void Paint_area::load(const std::string& filename) {
+    const Mapped_file file{filename};
+    if (file.is_open()) {
+        this->read(file.begin(), file.end());
+    }
+}
+
+void Paint_area::read(const char* first, const char* last) {
+    const std::size_t size = last - first;
+    if (Glyph_file::has_signature(first, size)) {
+        try {
+            const Glyph_file file{first, size};
+            canvas_.clear();
+            history_.clear();
+            file.for_each_run([this](std::size_t x, std::size_t y,
+                                     std::size_t length, const Glyph& glyph) {
+                if (x < max_canvas_length && y < max_canvas_length) {
+                    canvas_.set_row(Point{x, y},
+                                    std::min(length, max_canvas_length - x),
+                                    glyph);
+                }
+            });
+        } catch (const std::runtime_error&) {
+            return;
         }
-        ++current.x;
-        if (sym == L'\n') {
-            ++current.y;
-            current.x = 0;
+        this->repaint();
+        return;
+    }
+    canvas_.clear();
+    history_.clear();
+    for (std::size_t y{0}; first != last && y < max_canvas_length; ++y) {
+        const char* end_of_line = std::find(first, last, '\n');
+        const Glyph_string line{std::string{first, end_of_line}};
+        std::size_t x{0};
+        for (const Glyph& glyph : line) {
+            if (x == max_canvas_length) {
+                break;
+            }
+            if (glyph.symbol != L' ' && glyph.symbol != L'\r') {
+                canvas_.set(Point{x, y}, glyph);
+            }
+            ++x;
         }
+        first = end_of_line == last ? last : end_of_line + 1;
     }
+    this->repaint();
 }
 
 bool Paint_area::paint_event() {
     Painter p{*this};
-    for (const auto& gc_pair : glyphs_painted_) {
-        if (gc_pair.first.x < this->width() &&
-            gc_pair.first.y < this->height()) {
-            p.put(gc_pair.second, gc_pair.first);
-        }
+    if (repaint_all_ || !damage_) {
+        canvas_.for_each_in(Point{0, 0}, Area{this->width(), this->height()},
+                            [&p](Point position, const Glyph& glyph) {
+                                p.put(glyph, position);
+                            });
+    } else {
+        this->paint_damage(p);
     }
+    repaint_all_ = false;
+    damage_ = opt::none;
     return Widget::paint_event();
 }
 
@@ -194,16 +255,50 @@ bool Paint_area::mouse_press_event(const Mouse::State& mouse) {
     if (mouse.button == Mouse::Button::Right) {
         this->remove_glyph(mouse.local);
     } else if (mouse.button == Mouse::Button::Middle) {
-        if (glyphs_painted_.count(mouse.local) == 1) {
-            this->set_glyph(glyphs_painted_[mouse.local]);
+        const Glyph* painted{canvas_.at(mouse.local)};
+        if (painted != nullptr) {
+            this->set_glyph(*painted);
         }
-    } else {
+    } else if (mouse.button != Mouse::Button::Left || clone_enabled_ ||
+               tool_ == Tool::Brush) {
         this->place_glyph(mouse.local.x, mouse.local.y);
+    } else if (tool_ == Tool::Fill) {
+        this->fill(mouse.local);
+    } else if (anchor_) {
+        this->finish_shape(mouse.local);
+    } else {
+        anchor_ = mouse.local;
     }
     return Widget::mouse_press_event(mouse);
 }
 
+bool Paint_area::mouse_release_event(const Mouse::State& mouse) {
+    if (mouse.button == Mouse::Button::Left && anchor_ &&
+        *anchor_ != mouse.local) {
+        this->finish_shape(mouse.local);
+    }
+    return Widget::mouse_release_event(mouse);
+}
+
+bool Paint_area::resize_event(Area new_size, Area old_size) {
+    this->repaint();
+    return Widget::resize_event(new_size, old_size);
+}
+
+bool Paint_area::enable_event() {
+    this->repaint();
+    return Widget::enable_event();
+}
+
 bool Paint_area::key_press_event(const Key::State& keyboard) {
+    if (keyboard.key == Key::Ctrl_z) {
+        this->undo();
+        return Widget::key_press_event(keyboard);
+    }
+    if (keyboard.key == Key::Ctrl_y) {
+        this->redo();
+        return Widget::key_press_event(keyboard);
+    }
     if (!this->cursor.enabled()) {
         if (!std::iscntrl(keyboard.symbol)) {
             this->set_symbol(keyboard.symbol);
@@ -250,23 +345,205 @@ bool Paint_area::key_press_event(const Key::State& keyboard) {
 
 void Paint_area::place_glyph(std::size_t x, std::size_t y) {
     if (clone_enabled_) {
-        if (glyphs_painted_.count(Point{x, y}) == 1) {
-            this->set_glyph(glyphs_painted_[Point{x, y}]);
+        const Glyph* painted{canvas_.at(Point{x, y})};
+        if (painted != nullptr) {
+            this->set_glyph(*painted);
             this->toggle_clone();
         }
     } else if (erase_enabled_) {
         this->remove_glyph(Point{x, y});
     } else {
-        glyphs_painted_[Point{x, y}] = current_glyph_;
-        this->update();
+        Canvas_edit edit{current_glyph_, false};
+        this->paint_cell(edit, Point{x, y});
+        this->commit(std::move(edit));
     }
 }
 
 void Paint_area::remove_glyph(Point coords) {
-    glyphs_painted_.erase(coords);
+    if (canvas_.at(coords) != nullptr) {
+        Canvas_edit edit{Glyph{}, true};
+        edit.remember(canvas_, coords);
+        canvas_.erase(coords);
+        this->commit(std::move(edit));
+    }
+}
+
+void Paint_area::paint_cell(Canvas_edit& edit, Point p) {
+    edit.remember(canvas_, p);
+    if (erase_enabled_) {
+        canvas_.erase(p);
+    } else {
+        canvas_.set(p, current_glyph_);
+    }
+}
+
+void Paint_area::commit(Canvas_edit edit) {
+    if (!edit.empty()) {
+        this->damage(edit.top_left(), edit.bottom_right());
+        history_.push(std::move(edit));
+    }
+}
+
+void Paint_area::fill(Point seed) {
+    if (seed.x >= this->width() || seed.y >= this->height()) {
+        return;
+    }
+    const Glyph* seed_glyph{canvas_.at(seed)};
+    const bool target_painted{seed_glyph != nullptr};
+    const Glyph target{target_painted ? *seed_glyph : Glyph{}};
+    if (target_painted ? !erase_enabled_ && target == current_glyph_
+                       : erase_enabled_) {
+        return;
+    }
+    const auto matches = [this, target_painted, &target](Point p) {
+        const Glyph* glyph{canvas_.at(p)};
+        return glyph == nullptr ? !target_painted
+                                : target_painted && *glyph == target;
+    };
+    Canvas_edit edit{current_glyph_, erase_enabled_};
+    // Each seed is the first matching cell of a run on a row next to a span
+    // that has been filled, so only the filled area and its edge are visited.
+    std::vector<Point> seeds{seed};
+    while (!seeds.empty()) {
+        const Point p{seeds.back()};
+        seeds.pop_back();
+        if (!matches(p)) {
+            continue;
+        }
+        std::size_t left{p.x};
+        std::size_t right{p.x};
+        while (left > 0 && matches(Point{left - 1, p.y})) {
+            --left;
+        }
+        while (right + 1 < this->width() && matches(Point{right + 1, p.y})) {
+            ++right;
+        }
+        for (std::size_t x{left}; x <= right; ++x) {
+            edit.remember(canvas_, Point{x, p.y});
+        }
+        if (erase_enabled_) {
+            for (std::size_t x{left}; x <= right; ++x) {
+                canvas_.erase(Point{x, p.y});
+            }
+        } else {
+            canvas_.set_row(Point{left, p.y}, right - left + 1, current_glyph_);
+        }
+        for (std::size_t y : {p.y - 1, p.y + 1}) {
+            if (y >= this->height()) {  // Also catches 0 - 1.
+                continue;
+            }
+            bool in_run{false};
+            for (std::size_t x{left}; x <= right; ++x) {
+                const bool match{matches(Point{x, y})};
+                if (match && !in_run) {
+                    seeds.push_back(Point{x, y});
+                }
+                in_run = match;
+            }
+        }
+    }
+    this->commit(std::move(edit));
+}
+
+void Paint_area::draw_rectangle(Point a, Point b) {
+    const Point top_left{std::min(a.x, b.x), std::min(a.y, b.y)};
+    const Point bottom_right{std::max(a.x, b.x), std::max(a.y, b.y)};
+    Canvas_edit edit{current_glyph_, erase_enabled_};
+    for (std::size_t x{top_left.x}; x <= bottom_right.x; ++x) {
+        this->paint_cell(edit, Point{x, top_left.y});
+        this->paint_cell(edit, Point{x, bottom_right.y});
+    }
+    for (std::size_t y{top_left.y + 1}; y < bottom_right.y; ++y) {
+        this->paint_cell(edit, Point{top_left.x, y});
+        this->paint_cell(edit, Point{bottom_right.x, y});
+    }
+    this->commit(std::move(edit));
+}
+
+void Paint_area::draw_line(Point a, Point b) {
+    // Bresenham's algorithm, error is kept signed.
+    const auto distance = [](std::size_t from, std::size_t to) {
+        return static_cast<std::ptrdiff_t>(from < to ? to - from : from - to);
+    };
+    const std::ptrdiff_t dx{distance(a.x, b.x)};
+    const std::ptrdiff_t dy{-distance(a.y, b.y)};
+    std::ptrdiff_t error{dx + dy};
+    Canvas_edit edit{current_glyph_, erase_enabled_};
+    Point p{a};
+    while (true) {
+        this->paint_cell(edit, p);
+        if (p == b) {
+            break;
+        }
+        const std::ptrdiff_t doubled{2 * error};
+        if (doubled >= dy) {
+            error += dy;
+            p.x = a.x < b.x ? p.x + 1 : p.x - 1;
+        }
+        if (doubled <= dx) {
+            error += dx;
+            p.y = a.y < b.y ? p.y + 1 : p.y - 1;
+        }
+    }
+    this->commit(std::move(edit));
+}
+
+void Paint_area::finish_shape(Point p) {
+    if (tool_ == Tool::Rectangle) {
+        this->draw_rectangle(*anchor_, p);
+    } else if (tool_ == Tool::Line) {
+        this->draw_line(*anchor_, p);
+    }
+    anchor_ = opt::none;
+}
+
+void Paint_area::damage(Point a, Point b) {
+    const Point top_left{std::min(a.x, b.x), std::min(a.y, b.y)};
+    const Point bottom_right{std::max(a.x, b.x), std::max(a.y, b.y)};
+    if (!damage_) {
+        damage_ = Damage{top_left, bottom_right};
+    } else {
+        Damage& d{*damage_};
+        d.top_left.x = std::min(d.top_left.x, top_left.x);
+        d.top_left.y = std::min(d.top_left.y, top_left.y);
+        d.bottom_right.x = std::max(d.bottom_right.x, bottom_right.x);
+        d.bottom_right.y = std::max(d.bottom_right.y, bottom_right.y);
+    }
+    this->update();
+}
+
+void Paint_area::repaint() {
+    repaint_all_ = true;
     this->update();
 }
 
+void Paint_area::paint_damage(Painter& p) {
+    p.keep_previous();
+    const Damage& d{*damage_};
+    const Point top_left{d.top_left};
+    const std::size_t right{std::min(d.bottom_right.x + 1, this->width())};
+    const std::size_t bottom{std::min(d.bottom_right.y + 1, this->height())};
+    if (right <= top_left.x || bottom <= top_left.y) {
+        return;
+    }
+    const Area size{right - top_left.x, bottom - top_left.y};
+    std::vector<bool> painted(size.width * size.height, false);
+    canvas_.for_each_in(
+        top_left, size, [&p, &painted, &top_left, &size](Point position,
+                                                        const Glyph& glyph) {
+            p.put(glyph, position);
+            painted[(position.y - top_left.y) * size.width +
+                    (position.x - top_left.x)] = true;
+        });
+    for (std::size_t y{0}; y < size.height; ++y) {
+        for (std::size_t x{0}; x < size.width; ++x) {
+            if (!painted[y * size.width + x]) {
+                p.erase(top_left.x + x, top_left.y + y);
+            }
+        }
+    }
+}
+
 namespace slot {
 
 sig::Slot<void(Glyph)> set_glyph(Paint_area& pa) {
@@ -344,6 +621,12 @@ sig::Slot<void()> remove_attribute(Paint_area& pa, Attribute attr) {
     return slot;
 }
 
+sig::Slot<void()> set_tool(Paint_area& pa, Paint_area::Tool tool) {
+    sig::Slot<void()> slot{[&pa, tool] { pa.set_tool(tool); }};
+    slot.track(pa.destroyed);
+    return slot;
+}
+
 sig::Slot<void()> toggle_clone(Paint_area& pa) {
     sig::Slot<void()> slot{[&pa] { pa.toggle_clone(); }};
     slot.track(pa.destroyed);
@@ -394,6 +677,13 @@ sig::Slot<void(std::istream&)> read(Paint_area& pa) {
     return slot;
 }
 
+sig::Slot<void(const std::string&)> load(Paint_area& pa) {
+    sig::Slot<void(const std::string&)> slot{
+        [&pa](const std::string& filename) { pa.load(filename); }};
+    slot.track(pa.destroyed);
+    return slot;
+}
+
 }  // namespace slot
 }  // namespace glyph_paint
 }  // namespace demos
@@ -3,24 +3,44 @@
 #include <cstddef>
 #include <cstdint>
 #include <iostream>
-#include <unordered_map>
+#include <string>
 
 #include <cppurses/painter/attribute.hpp>
 #include <cppurses/painter/color.hpp>
 #include <cppurses/painter/glyph.hpp>
+#include <cppurses/painter/painter.hpp>
 #include <cppurses/system/events/key.hpp>
 #include <cppurses/system/events/mouse.hpp>
+#include <cppurses/system/undo_stack.hpp>
+#include <cppurses/widget/area.hpp>
+#include <cppurses/widget/point.hpp>
 #include <cppurses/widget/widget.hpp>
 
+#include <optional/optional.hpp>
 #include <signals/signals.hpp>
 
+#include "canvas.hpp"
+#include "canvas_edit.hpp"
+
 namespace demos {
 namespace glyph_paint {
 
 class Paint_area : public cppurses::Widget {
    public:
+    /// What a left click paints.
+    /** Rectangle and Line are drawn between two clicks, or from a press to a
+     *  release in another cell. Fill paints the area of matching cells that is
+     *  connected to the clicked cell, within the visible area. */
+    enum class Tool { Brush, Fill, Rectangle, Line };
+
+    /// Width and height of the drawing, loaded files are clipped to it.
+    static constexpr std::size_t max_canvas_length{4096};
+
     Paint_area();
 
+    /// Paint with \p tool from now on, drops a rectangle or line in progress.
+    void set_tool(Tool tool);
+
     void set_glyph(cppurses::Glyph glyph);
     void set_symbol(const cppurses::Glyph& symbol);
     void set_foreground_color(cppurses::Color c);
@@ -28,8 +48,15 @@ class Paint_area : public cppurses::Widget {
     void set_attribute(cppurses::Attribute attr);
     void remove_attribute(cppurses::Attribute attr);
 
+    /// Erase the drawing, can be undone.
     void clear();
 
+    /// Revert the last edit, no-op if there is none. Also on Ctrl-z.
+    void undo();
+
+    /// Reapply the last undone edit, no-op if there is none. Also on Ctrl-y.
+    void redo();
+
     cppurses::Glyph glyph() const;
     void toggle_clone();
     void enable_erase();
@@ -37,9 +64,18 @@ class Paint_area : public cppurses::Widget {
     void enable_grid();
     void disable_grid();
 
+    /// Write the drawing, with its colors and Attributes, as a glyph file.
     void write(std::ostream& os);
+
+    /// Replace the drawing with a glyph file or plain text read from \p is.
+    /** Cells past max_canvas_length in either direction are dropped. */
     void read(std::istream& is);
 
+    /// Replace the drawing with the contents of \p filename.
+    /** The file is memory mapped, glyph files are copied straight from it
+     *  into the canvas. Files that fail to load leave the drawing as is. */
+    void load(const std::string& filename);
+
     // Signals
     sig::Signal<void(cppurses::Glyph)> glyph_changed;
     sig::Signal<void()> erase_enabled;
@@ -50,17 +86,68 @@ class Paint_area : public cppurses::Widget {
 
     bool mouse_press_event(const cppurses::Mouse::State& mouse) override;
 
+    bool mouse_release_event(const cppurses::Mouse::State& mouse) override;
+
     bool key_press_event(const cppurses::Key::State& keyboard) override;
 
+    bool resize_event(cppurses::Area new_size,
+                      cppurses::Area old_size) override;
+
+    bool enable_event() override;
+
    private:
-    std::unordered_map<cppurses::Point, cppurses::Glyph> glyphs_painted_;
+    Canvas canvas_;
+    cppurses::Undo_stack<Canvas_edit> history_;
     cppurses::Glyph current_glyph_{L'x'};
     cppurses::Glyph before_erase_{L'x'};
     bool clone_enabled_{false};
     bool erase_enabled_{false};
+    Tool tool_{Tool::Brush};
+    // Where the rectangle or line being drawn starts.
+    opt::Optional<cppurses::Point> anchor_;
+
+    /// Cells changed since the last paint_event, both corners inclusive.
+    struct Damage {
+        cppurses::Point top_left;
+        cppurses::Point bottom_right;
+    };
+    opt::Optional<Damage> damage_;
+    bool repaint_all_{true};
 
     void place_glyph(std::size_t x, std::size_t y);
     void remove_glyph(cppurses::Point coords);
+
+    /// Paint the current glyph at \p p, or erase it if the eraser is enabled.
+    /** The previous contents of \p p are remembered in \p edit. */
+    void paint_cell(Canvas_edit& edit, cppurses::Point p);
+
+    /// Add \p edit to the history, and repaint the cells it changed.
+    void commit(Canvas_edit edit);
+
+    /// Paint the region of cells matching \p seed that it is connected to.
+    void fill(cppurses::Point seed);
+
+    /// Paint the outline of the rectangle with corners \p a and \p b.
+    void draw_rectangle(cppurses::Point a, cppurses::Point b);
+
+    /// Paint a straight line from \p a to \p b.
+    void draw_line(cppurses::Point a, cppurses::Point b);
+
+    /// Draw the current Tool's shape from anchor_ to \p p and drop anchor_.
+    void finish_shape(cppurses::Point p);
+
+    /// Add the rectangle with corners \p a and \p b to the damaged area.
+    /** Posts a paint event that repaints only the damaged area. */
+    void damage(cppurses::Point a, cppurses::Point b);
+
+    /// Post a paint event that repaints the entire visible drawing.
+    void repaint();
+
+    /// Bring only the damaged cells on screen up to date.
+    void paint_damage(cppurses::Painter& p);
+
+    /// Replace the drawing with the glyph file or plain text in [first, last).
+    void read(const char* first, const char* last);
 };
 
 namespace slot {
@@ -83,6 +170,8 @@ sig::Slot<void()> set_attribute(Paint_area& pa, cppurses::Attribute attr);
 sig::Slot<void(cppurses::Attribute)> remove_attribute(Paint_area& pa);
 sig::Slot<void()> remove_attribute(Paint_area& pa, cppurses::Attribute attr);
 
+sig::Slot<void()> set_tool(Paint_area& pa, Paint_area::Tool tool);
+
 sig::Slot<void()> toggle_clone(Paint_area& pa);
 
 sig::Slot<void()> clear(Paint_area& pa);
@@ -95,6 +184,7 @@ sig::Slot<void()> disable_grid(Paint_area& pa);
 
 sig::Slot<void(std::ostream&)> write(Paint_area& pa);
 sig::Slot<void(std::istream&)> read(Paint_area& pa);
+sig::Slot<void(const std::string&)> load(Paint_area& pa);
 
 }  // namespace slot
 }  // namespace glyph_paint
@@ -2,35 +2,49 @@
 
 #include <cppurses/painter/attribute.hpp>
 #include <cppurses/painter/color.hpp>
+#include <cppurses/painter/glyph_string.hpp>
+#include <cppurses/system/events/custom_event.hpp>
 #include <cppurses/system/focus.hpp>
+#include <cppurses/system/system.hpp>
 #include <cppurses/widget/border.hpp>
 #include <cppurses/widget/focus_policy.hpp>
 #include <cppurses/widget/widget_slots.hpp>
 
+#include <algorithm>
+#include <codecvt>
+#include <cstdio>
 #include <fstream>
-#include <sstream>
+#include <locale>
+#include <memory>
+#include <mutex>
+#include <stdexcept>
 #include <string>
 #include <utility>
+#include <vector>
 
 namespace {
 
-void save_file(const std::string& filename, const std::string& output)
-{
-    std::ofstream ofs(filename);
-    if (!ofs.fail())
-        ofs << output;
-}
+/// Bytes read, or Glyphs written, per block.
+constexpr std::size_t block_size{1 << 16};
 
-std::string load_file(const std::string& filename)
+/// Return the length of the complete UTF-8 sequences at the front of [0, n).
+/** The bytes after it begin a sequence that continues in the next block. */
+std::size_t complete_length(const char* bytes, std::size_t n)
 {
-    std::ifstream ifs(filename);
-    if (ifs.fail())
-        return "";
-    std::ostringstream oss;
-    ifs >> oss.rdbuf();
-    if (ifs.fail() && !ifs.eof())
-        return "";
-    return oss.str();
+    for (std::size_t back{1}; back <= 4 && back <= n; ++back) {
+        const auto byte = static_cast<unsigned char>(bytes[n - back]);
+        if ((byte & 0xC0) == 0x80)
+            continue;
+        std::size_t length{1};
+        if ((byte & 0xE0) == 0xC0)
+            length = 2;
+        else if ((byte & 0xF0) == 0xE0)
+            length = 3;
+        else if ((byte & 0xF8) == 0xF0)
+            length = 4;
+        return length > back ? n - back : n;
+    }
+    return n;
 }
 
 }  // namespace
@@ -116,6 +130,7 @@ Save_area::Save_area()
     load_btn.set_name("Save_area - load_btn");
     filename_edit.set_name("Save_area - filename_edit");
     save_btn.set_name("Save_area - save_btn");
+    status.set_name("Save_area - status");
 }
 
 void Save_area::initialize()
@@ -134,6 +149,10 @@ void Save_area::initialize()
     // Save Button
     save_btn.width_policy.fixed(6);
     save_btn.brush.set_background(Color::Blue);
+
+    // Load and Save Progress
+    status.width_policy.fixed(12);
+    status.set_alignment(Alignment::Center);
 }
 
 Notepad::Notepad()
@@ -143,23 +162,259 @@ Notepad::Notepad()
     this->set_name("Notepad - main demo widget");
 }
 
+constexpr std::size_t Notepad::max_pending_blocks;
+
+Notepad::~Notepad() { this->cancel(); }
+
 bool Notepad::focus_in_event()
 {
     Focus::set_focus_to(txt_attr.textbox);
     return true;
 }
 
-void Notepad::initialize()
+bool Notepad::disable_event()
 {
-    // Signals
-    save_area.load_btn.clicked.connect([this] {
-        txt_attr.textbox.set_contents(
-            ::load_file(save_area.filename_edit.contents().str()));
+    // Blocks posted while disabled would be dropped, leaving a gap.
+    if (loading_ || copying_) {
+        this->cancel();
+        loading_ = false;
+        copying_ = false;
+        save_area.status.set_contents("Cancelled");
+    }
+    return layout::Vertical::disable_event();
+}
+
+void Notepad::load(const std::string& filename)
+{
+    this->cancel();
+    {
+        std::lock_guard<std::mutex> lock{pending_mtx_};
+        pending_blocks_ = 0;
+    }
+    loading_ = true;
+    txt_attr.textbox.clear();
+    save_area.status.set_contents("Loading");
+    const auto transfer = transfer_.load();
+    worker_.submit(
+        [this, transfer, filename] { this->read_blocks(transfer, filename); });
+}
+
+void Notepad::save(const std::string& filename)
+{
+    if (loading_)
+        return;
+    this->cancel();
+    save_area.status.set_contents("Saving");
+    {
+        std::lock_guard<std::mutex> lock{pending_mtx_};
+        save_blocks_.clear();
+        save_copied_ = false;
+    }
+    save_filename_ = filename;
+    copied_ = 0;
+    copying_ = true;
+    text_changed_ = false;
+    const auto transfer = transfer_.load();
+    const auto length = txt_attr.textbox.contents().size();
+    this->copy_blocks(transfer);
+    worker_.submit([this, transfer, filename, length] {
+        this->write_blocks(transfer, filename, length);
     });
+}
 
-    save_area.save_btn.clicked.connect([this] {
-        ::save_file(save_area.filename_edit.contents().str(),
-                    txt_attr.textbox.contents().str());
+void Notepad::cancel()
+{
+    {
+        std::lock_guard<std::mutex> lock{pending_mtx_};
+        ++transfer_;
+    }
+    blocks_changed_.notify_all();
+}
+
+void Notepad::read_blocks(std::size_t transfer, const std::string& filename)
+{
+    std::ifstream ifs(filename, std::ios::binary);
+    if (ifs.fail()) {
+        this->post_status(transfer, "Can't open", true);
+        return;
+    }
+    ifs.seekg(0, std::ios::end);
+    const std::streamoff size{ifs.tellg()};
+    ifs.clear();
+    ifs.seekg(0, std::ios::beg);
+    if (size > 0) {
+        // A Glyph per byte at most, growing the contents by copying would
+        // stall the main thread for longer as the text gets larger.
+        System::post_event<Custom_event>(*this, [this, transfer, size] {
+            if (transfer_ == transfer)
+                txt_attr.textbox.reserve(size);
+        });
+    }
+    std::wstring_convert<std::codecvt_utf8<wchar_t>> converter;
+    std::vector<char> buffer(block_size);
+    std::size_t carried{0};
+    std::size_t bytes_read{0};
+    while (ifs) {
+        ifs.read(buffer.data() + carried, block_size - carried);
+        const std::size_t count{carried + ifs.gcount()};
+        bytes_read += ifs.gcount();
+        const std::size_t length{ifs ? complete_length(buffer.data(), count)
+                                     : count};
+        auto block = std::make_shared<Glyph_string>();
+        try {
+            *block = Glyph_string{converter.from_bytes(
+                buffer.data(), buffer.data() + length)};
+        } catch (const std::range_error&) {
+            this->post_status(transfer, "Not UTF-8", true);
+            return;
+        }
+        carried = count - length;
+        std::copy(buffer.data() + length, buffer.data() + count, buffer.data());
+        if (block->empty())
+            continue;
+        {
+            std::unique_lock<std::mutex> lock{pending_mtx_};
+            blocks_changed_.wait(lock, [this, transfer] {
+                return pending_blocks_ < max_pending_blocks ||
+                       transfer_ != transfer;
+            });
+            if (transfer_ != transfer)
+                return;
+            ++pending_blocks_;
+        }
+        const int percent =
+            size > 0 ? static_cast<int>(bytes_read * 100 / size) : 0;
+        System::post_event<Custom_event>(*this, [this, transfer, block,
+                                                 percent] {
+            this->take_block(transfer, *block, percent);
+        });
+    }
+    if (ifs.bad()) {
+        this->post_status(transfer, "Can't read", true);
+        return;
+    }
+    this->post_status(transfer, "Loaded", true);
+}
+
+void Notepad::write_blocks(std::size_t transfer,
+                           const std::string& filename,
+                           std::size_t length)
+{
+    const auto temp = filename + ".tmp";
+    std::ofstream ofs(temp, std::ios::binary);
+    if (ofs.fail()) {
+        this->post_status(transfer, "Can't save", true);
+        return;
+    }
+    std::wstring_convert<std::codecvt_utf8<wchar_t>> converter;
+    std::wstring symbols;
+    std::size_t written{0};
+    int shown_percent{0};
+    while (ofs) {
+        {
+            std::unique_lock<std::mutex> lock{pending_mtx_};
+            blocks_changed_.wait(lock, [this, transfer] {
+                return transfer_ != transfer || !save_blocks_.empty() ||
+                       save_copied_;
+            });
+            if (transfer_ != transfer) {
+                lock.unlock();
+                ofs.close();
+                std::remove(temp.c_str());
+                return;
+            }
+            if (save_blocks_.empty())
+                break;
+            symbols = std::move(save_blocks_.front());
+            save_blocks_.pop_front();
+        }
+        System::post_event<Custom_event>(
+            *this, [this, transfer] { this->copy_blocks(transfer); });
+        try {
+            ofs << converter.to_bytes(symbols);
+        } catch (const std::range_error&) {
+            ofs.setstate(std::ios::failbit);
+        }
+        written += symbols.size();
+        const auto percent = static_cast<int>(written * 100 / length);
+        if (percent != shown_percent) {
+            shown_percent = percent;
+            this->post_status(transfer,
+                              "Saving " + std::to_string(percent) + '%', false);
+        }
+    }
+    ofs.close();
+    if (ofs.fail() || std::rename(temp.c_str(), filename.c_str()) != 0) {
+        std::remove(temp.c_str());
+        this->post_status(transfer, "Can't save", true);
+        return;
+    }
+    this->post_status(transfer, "Saved", true);
+}
+
+void Notepad::copy_blocks(std::size_t transfer)
+{
+    if (transfer_ != transfer || !copying_)
+        return;
+    if (text_changed_) {
+        // Blocks already written no longer match the text, start over.
+        this->save(save_filename_);
+        return;
+    }
+    const Glyph_string& text{txt_attr.textbox.contents()};
+    {
+        std::lock_guard<std::mutex> lock{pending_mtx_};
+        while (save_blocks_.size() < max_pending_blocks &&
+               copied_ < text.size()) {
+            const auto last = std::min(copied_ + block_size, text.size());
+            std::wstring symbols;
+            symbols.reserve(last - copied_);
+            for (; copied_ < last; ++copied_)
+                symbols.push_back(text[copied_].symbol);
+            save_blocks_.push_back(std::move(symbols));
+        }
+        if (copied_ == text.size()) {
+            save_copied_ = true;
+            copying_ = false;
+        }
+    }
+    blocks_changed_.notify_all();
+}
+
+void Notepad::take_block(std::size_t transfer, Glyph_string& block, int percent)
+{
+    {
+        std::lock_guard<std::mutex> lock{pending_mtx_};
+        if (transfer_ != transfer)
+            return;
+        --pending_blocks_;
+    }
+    blocks_changed_.notify_all();
+    txt_attr.textbox.append(std::move(block));
+    save_area.status.set_contents("Loading " + std::to_string(percent) + '%');
+}
+
+void Notepad::post_status(std::size_t transfer, std::string text, bool finished)
+{
+    System::post_event<Custom_event>(*this, [this, transfer, text, finished] {
+        if (transfer_ != transfer)
+            return;
+        if (finished)
+            loading_ = false;
+        save_area.status.set_contents(text);
     });
 }
+
+void Notepad::initialize()
+{
+    // Signals
+    save_area.load_btn.clicked.connect(
+        [this] { this->load(save_area.filename_edit.contents().str()); });
+
+    save_area.save_btn.clicked.connect(
+        [this] { this->save(save_area.filename_edit.contents().str()); });
+
+    txt_attr.textbox.contents_modified.connect(
+        [this](const Glyph_string&) { text_changed_ = true; });
+}
 }  // namespace demos
@@ -1,5 +1,14 @@
 #ifndef DEMOS_NOTEPAD_NOTEPAD_HPP
 #define DEMOS_NOTEPAD_NOTEPAD_HPP
+#include <atomic>
+#include <condition_variable>
+#include <cstddef>
+#include <deque>
+#include <mutex>
+#include <string>
+
+#include <cppurses/painter/glyph_string.hpp>
+#include <cppurses/system/thread_pool.hpp>
 #include <cppurses/widget/layouts/horizontal.hpp>
 #include <cppurses/widget/layouts/vertical.hpp>
 #include <cppurses/widget/widgets/checkbox.hpp>
@@ -65,22 +74,87 @@ class Save_area : public cppurses::layout::Horizontal {
     cppurses::Textbox& filename_edit{this->make_child<cppurses::Textbox>()};
     cppurses::Push_button& save_btn{
         this->make_child<cppurses::Push_button>("Save")};
+    cppurses::Label& status{this->make_child<cppurses::Label>()};
 
    private:
     void initialize();
 };
 
+/// Text editor, files are loaded and saved in blocks on a worker thread.
+/** A loading file is appended to the Textbox one block at a time, so input is
+ *  handled between blocks. Saves go to a temporary file that replaces the
+ *  target once it is fully written. */
 class Notepad : public cppurses::layout::Vertical {
    public:
     Notepad();
 
+    /// Stop any running load or save, a partly saved file is discarded.
+    ~Notepad();
+
+    /// Replace the text with the contents of \p filename, in the background.
+    /** Cancels a load already running. */
+    void load(const std::string& filename);
+
+    /// Write the text to \p filename, in the background.
+    /** Ignored while a file is loading. The text is copied for the worker a
+     *  block at a time between events, so the main thread never copies all of
+     *  it at once. An edit made before every block is copied restarts the
+     *  save, edits made after that are left for the next save. */
+    void save(const std::string& filename);
+
    protected:
     bool focus_in_event() override;
+    bool disable_event() override;
 
    private:
+    /// Blocks handed between the threads but not yet taken.
+    static constexpr std::size_t max_pending_blocks{4};
+
     Text_and_attributes& txt_attr{this->make_child<Text_and_attributes>()};
     Save_area& save_area{this->make_child<Save_area>()};
+
+    // Incremented to cancel the running load or save.
+    std::atomic<std::size_t> transfer_{0};
+    bool loading_{false};
+    std::mutex pending_mtx_;
+    std::condition_variable blocks_changed_;
+    std::size_t pending_blocks_{0};
+    // Symbols copied from the Textbox, waiting to be saved.
+    std::deque<std::wstring> save_blocks_;
+    bool save_copied_{false};
+    // Main thread only, the save in progress of copying the text.
+    std::string save_filename_;
+    std::size_t copied_{0};
+    bool copying_{false};
+    bool text_changed_{false};
+    cppurses::Thread_pool worker_{1};
+
     void initialize();
+
+    /// Cancel the running load or save.
+    void cancel();
+
+    /// Worker thread, decode \p filename and post it in blocks.
+    void read_blocks(std::size_t transfer, const std::string& filename);
+
+    /// Worker thread, write the copied blocks to \p filename, through a
+    /// temporary file.
+    /** \p length is the number of Glyphs in the text, for the progress. */
+    void write_blocks(std::size_t transfer,
+                      const std::string& filename,
+                      std::size_t length);
+
+    /// Main thread, copy blocks of the text until max_pending_blocks wait.
+    void copy_blocks(std::size_t transfer);
+
+    /// Main thread, append a decoded block to the Textbox.
+    void take_block(std::size_t transfer,
+                    cppurses::Glyph_string& block,
+                    int percent);
+
+    /// Have \p text shown in the status Label if \p transfer is not cancelled.
+    /** A \p finished load stops blocking saves. */
+    void post_status(std::size_t transfer, std::string text, bool finished);
 };
 }  // namespace demos
 #endif  // DEMOS_NOTEPAD_NOTEPAD_HPP
@@ -1,10 +1,9 @@
 #include "color_control.hpp"
 
 #include <cppurses/system/system.hpp>
+#include <cppurses/terminal/terminal.hpp>
 #include <cppurses/widget/border.hpp>
 
-#include "palette_helpers.hpp"
-
 namespace {
 using namespace cppurses;
 
@@ -27,11 +26,10 @@ Color_control::Color_control() {
 }
 
 void Color_control::set_sliders(cppurses::Color color) {
-    auto palette = cppurses::System::terminal.current_palette();
-    const auto& definition = detail::extract_definition(palette, color);
-    this->set_red_slider(definition.values.red);
-    this->set_green_slider(definition.values.green);
-    this->set_blue_slider(definition.values.blue);
+    const auto values = cppurses::System::terminal.color_values(color);
+    this->set_red_slider(values.red);
+    this->set_green_slider(values.green);
+    this->set_blue_slider(values.blue);
 }
 
 }  // namespace palette
@@ -1,8 +1,9 @@
 #include "color_definition_setter.hpp"
 
 #include <cppurses/painter/color.hpp>
-
-#include "palette_helpers.hpp"
+#include <cppurses/painter/color_definition.hpp>
+#include <cppurses/system/system.hpp>
+#include <cppurses/terminal/terminal.hpp>
 
 using namespace cppurses;
 
@@ -17,18 +18,60 @@ Color_definition_setter::Color_definition_setter() {
 
     this->change_current_color(Color::White);
 
-    using namespace palette::detail;
-    color_control_.red_changed.connect(
-        [this](int red_value) { set_red(current_color_, red_value); });
-    color_control_.green_changed.connect(
-        [this](int green_value) { set_green(current_color_, green_value); });
-    color_control_.blue_changed.connect(
-        [this](int blue_value) { set_blue(current_color_, blue_value); });
+    color_control_.red_changed.connect([this](int red_value) {
+        values_.red = red_value;
+        this->request_send();
+    });
+    color_control_.green_changed.connect([this](int green_value) {
+        values_.green = green_value;
+        this->request_send();
+    });
+    color_control_.blue_changed.connect([this](int blue_value) {
+        values_.blue = blue_value;
+        this->request_send();
+    });
+}
+
+Color_definition_setter::~Color_definition_setter() {
+    if (animating_) {
+        this->disable_animation();
+    }
 }
 
 void Color_definition_setter::change_current_color(Color color) {
+    // Finish the previous color before the sliders move to the new one.
+    if (pending_) {
+        this->send();
+    }
     current_color_ = color;
+    values_ = System::terminal.color_values(color);
     color_display_.set_color(color);
     color_control_.set_sliders(color);
 }
+
+bool Color_definition_setter::timer_event() {
+    if (pending_) {
+        this->send();
+    } else {
+        this->disable_animation();
+        animating_ = false;
+    }
+    return layout::Vertical::timer_event();
+}
+
+void Color_definition_setter::request_send() {
+    pending_ = true;
+    if (Clock_t::now() - last_sent_ >= frame_period_) {
+        this->send();
+    } else if (!animating_) {
+        this->enable_animation(frame_period_);
+        animating_ = true;
+    }
+}
+
+void Color_definition_setter::send() {
+    System::terminal.set_color_definition({current_color_, values_});
+    pending_ = false;
+    last_sent_ = Clock_t::now();
+}
 }  // namespace palette
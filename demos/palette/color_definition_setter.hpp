@@ -1,9 +1,11 @@
 #ifndef CPPURSES_DEMOS_PALETTE_COLOR_DEFINITION_SETTER_HPP
 #define CPPURSES_DEMOS_PALETTE_COLOR_DEFINITION_SETTER_HPP
 #include <cctype>
+#include <chrono>
 #include <string>
 
 #include <cppurses/painter/color.hpp>
+#include <cppurses/painter/rgb.hpp>
 #include <cppurses/painter/painter.hpp>
 #include <cppurses/widget/layouts/vertical.hpp>
 #include <cppurses/widget/widgets/confirm_button.hpp>
@@ -17,9 +19,22 @@
 namespace palette {
 
 /// Provides interface and implementation of setting a specific color value.
+/** Slider changes are sent to the terminal at most once per frame, and only
+ *  for the color being set. A drag that moves several values between frames
+ *  is sent as its last value. */
 class Color_definition_setter : public cppurses::layout::Vertical {
+    using Clock_t = std::chrono::steady_clock;
+    using Period_t = std::chrono::milliseconds;
+
     cppurses::Color current_color_{cppurses::Color::White};
 
+    // Values set by the sliders, not yet sent if pending_.
+    cppurses::RGB values_{0, 0, 0};
+    bool pending_{false};
+    bool animating_{false};
+    Clock_t::time_point last_sent_;
+    Period_t frame_period_{16};
+
     Color_display& color_display_{
         this->make_child<Color_display>(current_color_)};
 
@@ -30,11 +45,24 @@ class Color_definition_setter : public cppurses::layout::Vertical {
    public:
     Color_definition_setter();
 
+    /// Stop the frame timer if a change is still waiting to be sent.
+    ~Color_definition_setter();
+
     /// Change the color you are setting the definition of.
     void change_current_color(cppurses::Color color);
 
     /// Return the color you are setting the definition of.
     cppurses::Color current_color() const { return current_color_; }
+
+   protected:
+    bool timer_event() override;
+
+   private:
+    /// Send values_ now if a frame has passed since the last send, or later.
+    void request_send();
+
+    /// Send values_ as the terminal definition of current_color_.
+    void send();
 };
 
 }  // namespace palette
@@ -2,6 +2,7 @@
 #define CPPURSES_SYSTEM_HPP
 
 #include <cppurses/system/events/child_event.hpp>
+#include <cppurses/system/events/custom_event.hpp>
 #include <cppurses/system/events/delete_event.hpp>
 #include <cppurses/system/events/disable_event.hpp>
 #include <cppurses/system/events/enable_event.hpp>
@@ -18,7 +19,10 @@
 #include <cppurses/system/event.hpp>
 #include <cppurses/system/event_loop.hpp>
 #include <cppurses/system/focus.hpp>
+#include <cppurses/system/mapped_file.hpp>
 #include <cppurses/system/shortcuts.hpp>
 #include <cppurses/system/system.hpp>
+#include <cppurses/system/thread_pool.hpp>
+#include <cppurses/system/undo_stack.hpp>
 
 #endif  // CPPURSES_SYSTEM_HPP
@@ -12,6 +12,8 @@
 #include <cppurses/widget/widgets/cycle_stack.hpp>
 #include <cppurses/widget/widgets/fixed_height.hpp>
 #include <cppurses/widget/widgets/fixed_width.hpp>
+#include <cppurses/widget/widgets/file_picker.hpp>
+#include <cppurses/widget/widgets/fuzzy_finder.hpp>
 #include <cppurses/widget/widgets/horizontal_scrollbar.hpp>
 #include <cppurses/widget/widgets/label.hpp>
 #include <cppurses/widget/widgets/labeled_cycle_box.hpp>
@@ -25,10 +27,12 @@
 #include <cppurses/widget/widgets/open_file.hpp>
 #include <cppurses/widget/widgets/push_button.hpp>
 #include <cppurses/widget/widgets/save_file.hpp>
+#include <cppurses/widget/widgets/scroll_area.hpp>
 #include <cppurses/widget/widgets/status_bar.hpp>
 #include <cppurses/widget/widgets/text_display.hpp>
 #include <cppurses/widget/widgets/textbox.hpp>
 #include <cppurses/widget/widgets/titlebar.hpp>
+#include <cppurses/widget/widgets/virtual_menu.hpp>
 #include <cppurses/widget/widgets/vertical_scrollbar.hpp>
 #include <cppurses/widget/widgets/vertical_slider.hpp>
 
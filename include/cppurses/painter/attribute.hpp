@@ -19,10 +19,11 @@ enum class Attribute : std::int8_t {
 
 /// Global list of all Attributes.
 /** Useful if querying a Brush for each Attribute with the
- *  Brush::has_attribute() function. Brush holds a std::bitset internally making
- *  a query about a specific Attribute quick. Returning a list of all set
- *  Attributes is expensive, requiring an allocation if using std::vector. Might
- *  change in the future to give a better interface. */
+ *  Brush::has_attribute() function. Brush packs the Attributes as bits of a
+ *  single integer, making a query about a specific Attribute a mask test.
+ *  Returning a list of all set Attributes is expensive, requiring an
+ *  allocation if using std::vector. Might change in the future to give a
+ *  better interface. */
 constexpr std::array<Attribute, 8> Attribute_list{
     Attribute::Bold,      Attribute::Italic, Attribute::Underline,
     Attribute::Standout,  Attribute::Dim,    Attribute::Inverse,
@@ -1,6 +1,5 @@
 #ifndef CPPURSES_PAINTER_BRUSH_HPP
 #define CPPURSES_PAINTER_BRUSH_HPP
-#include <bitset>
 #include <cstdint>
 #include <utility>
 
@@ -12,6 +11,9 @@
 namespace cppurses {
 
 /// Holds the look of any paintable object with Attributes and Colors.
+/** The Attributes and Colors are packed into a single integer, the style, so
+ *  comparing and imprinting Brushes costs a few integer operations and a Glyph
+ *  is no larger than its symbol and style. */
 class Brush {
    public:
     /// Construct a Brush with given Attributes and Colors.
@@ -45,32 +47,56 @@ class Brush {
     }
 
     /// Set the background color of this brush.
-    void set_background(Color color) { background_color_ = color; }
+    void set_background(Color color) {
+        style_ = (style_ & ~background_mask) | has_background |
+                 color_bits(color) << background_shift;
+    }
 
     /// Set the foreground color of this brush.
-    void set_foreground(Color color) { foreground_color_ = color; }
+    void set_foreground(Color color) {
+        style_ = (style_ & ~foreground_mask) | has_foreground |
+                 color_bits(color) << foreground_shift;
+    }
 
     /// Set the background to not have a color, the default state.
-    void remove_background() { background_color_ = opt::none; }
+    void remove_background() { style_ &= ~(background_mask | has_background); }
 
     /// Set the foreground to not have a color, the default state.
-    void remove_foreground() { foreground_color_ = opt::none; }
+    void remove_foreground() { style_ &= ~(foreground_mask | has_foreground); }
 
     /// Remove all of the set Attributes from the brush, not including colors.
-    void clear_attributes() { attributes_.reset(); }
+    void clear_attributes() { style_ &= ~attribute_mask; }
 
     /// Provide a check of whether the brush has the provided Attribute \p attr.
     bool has_attribute(Attribute attr) const {
-        return attributes_[static_cast<std::size_t>(attr)];
+        return (style_ & attribute_bit(attr)) != 0;
     }
 
     /// Return the current background as an opt::Optional object.
-    opt::Optional<Color> background_color() const { return background_color_; }
+    opt::Optional<Color> background_color() const {
+        if ((style_ & has_background) == 0) {
+            return opt::none;
+        }
+        return static_cast<Color>((style_ & background_mask) >>
+                                  background_shift);
+    }
 
     /// Return the current foreground as an opt::Optional object.
-    opt::Optional<Color> foreground_color() const { return foreground_color_; }
+    opt::Optional<Color> foreground_color() const {
+        if ((style_ & has_foreground) == 0) {
+            return opt::none;
+        }
+        return static_cast<Color>((style_ & foreground_mask) >>
+                                  foreground_shift);
+    }
+
+    /// Return the Attributes and Colors packed in a single integer.
+    /** Two Brushes are equal if and only if their styles are equal, so the
+     *  style can be used as a hash or as a key. */
+    std::uint32_t style() const { return style_; }
 
     friend bool operator==(const Brush& lhs, const Brush& rhs);
+    friend void imprint(const Brush& from, Brush& to);
 
    private:
     /// Used by add_attributes() to set a deail::BackgroundColor.
@@ -84,23 +110,37 @@ class Brush {
     }
 
     /// Used by add_attributes() to set an Attribute.
-    void set_attr(Attribute attr) {
-        attributes_.set(static_cast<std::int8_t>(attr));
-    }
+    void set_attr(Attribute attr) { style_ |= attribute_bit(attr); }
 
     /// Remove a specific Attribute, if it is set, otherwise no-op.
-    void unset_attr(Attribute attr) {
-        attributes_.set(static_cast<std::int8_t>(attr), false);
+    void unset_attr(Attribute attr) { style_ &= ~attribute_bit(attr); }
+
+    static std::uint32_t attribute_bit(Attribute attr) {
+        return std::uint32_t{1} << static_cast<int>(attr);
+    }
+
+    static std::uint32_t color_bits(Color color) {
+        return static_cast<std::uint8_t>(color);
     }
 
-    // Data Members
-    std::bitset<8> attributes_;
-    opt::Optional<Color> background_color_;
-    opt::Optional<Color> foreground_color_;
+    // Style layout: bits 0-7 are the Attributes, bits 8 and 9 are set if there
+    // is a background or a foreground color, bits 16-23 hold the background
+    // and bits 24-31 the foreground.
+    static constexpr std::uint32_t attribute_mask{0xFF};
+    static constexpr std::uint32_t has_background{1 << 8};
+    static constexpr std::uint32_t has_foreground{1 << 9};
+    static constexpr int background_shift{16};
+    static constexpr int foreground_shift{24};
+    static constexpr std::uint32_t background_mask{0xFFu << background_shift};
+    static constexpr std::uint32_t foreground_mask{0xFFu << foreground_shift};
+
+    std::uint32_t style_{0};
 };
 
 /// Compares if the held attributes and (back/fore)ground colors are equal.
-bool operator==(const Brush& lhs, const Brush& rhs);
+inline bool operator==(const Brush& lhs, const Brush& rhs) {
+    return lhs.style_ == rhs.style_;
+}
 
 /// Add Attributes and Colors from \p from to \p to.
 /** Does not overwrite existing colors in \p to. */
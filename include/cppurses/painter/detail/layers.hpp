@@ -0,0 +1,107 @@
+#ifndef CPPURSES_PAINTER_DETAIL_LAYERS_HPP
+#define CPPURSES_PAINTER_DETAIL_LAYERS_HPP
+#include <cstddef>
+#include <vector>
+
+#include <signals/connection.hpp>
+
+#include <cppurses/painter/detail/rect.hpp>
+#include <cppurses/painter/glyph.hpp>
+#include <cppurses/painter/glyph_matrix.hpp>
+#include <cppurses/widget/area.hpp>
+#include <cppurses/widget/point.hpp>
+
+namespace cppurses {
+class Widget;
+namespace detail {
+
+/// Composites overlay Widgets on top of the head Widget's tree.
+/** Layer zero is the base layer, drawn by the head Widget and its children.
+ *  Each overlay is a parentless Widget that forms its own layer, the last
+ *  overlay added is the top-most. Every tile written to the screen is cached
+ *  in the layer it belongs to, and is only sent to the terminal if no higher
+ *  layer covers it. When an overlay moves, shrinks or is removed, the cells
+ *  it no longer covers are restored from the caches of the layers below, so
+ *  no underlying Widget has to repaint. All coordinates are global. */
+class Layers {
+    Layers() = default;
+
+   public:
+    /// Return the global Layers object.
+    static auto get() -> Layers&
+    {
+        static Layers layers;
+        return layers;
+    }
+
+    /// Add \p overlay as the top-most layer, no-op if it is already a layer.
+    void add(Widget& overlay);
+
+    /// Remove \p overlay's layer, the cells it covered are restored on flush.
+    void remove(const Widget& overlay);
+
+    /// Return true if \p widg is an overlay.
+    bool is_overlay(const Widget& widg) const;
+
+    /// Return the top-most overlay covering (x, y), nullptr if there is none.
+    Widget* overlay_at(std::size_t x, std::size_t y) const;
+
+    /// Return the layer that \p widg paints to, zero for the base layer.
+    std::size_t layer_of(const Widget& widg) const;
+
+    /// Pick up overlay geometry changes and restore the cells left uncovered.
+    /** Must be called before any tiles are put for this flush. Returns true if
+     *  anything was written to the terminal. */
+    bool composite();
+
+    /// Cache \p tile in \p layer and write it to the terminal if it is visible.
+    void put(std::size_t layer,
+             std::size_t x,
+             std::size_t y,
+             const Glyph& tile);
+
+    /// Return true if \p tile is what \p layer already holds at (x, y).
+    /** Putting \p tile there again would not change the screen. */
+    bool holds(std::size_t layer,
+               std::size_t x,
+               std::size_t y,
+               const Glyph& tile) const;
+
+    /// Shift the rows of a rectangle in \p layer up by \p rows, down if < 0.
+    /** Shifts the layer's cache and the terminal. The rectangle has top left
+     *  (x, y) and size \p size, rows shifted in are blank. Returns false and
+     *  does nothing if a higher layer overlaps the rectangle. */
+    bool shift_rows(std::size_t layer,
+                    std::size_t x,
+                    std::size_t y,
+                    Area size,
+                    int rows);
+
+   private:
+    struct Overlay {
+        Widget* widget;
+        Rect rect;           // Geometry as of the last composite().
+        Glyph_matrix cache;  // In coordinates local to rect.
+        sig::Connection on_destroyed;
+    };
+
+    Glyph_matrix base_;
+    std::vector<Overlay> overlays_;  // Bottom to top.
+    std::vector<Rect> uncovered_;
+
+    /// Return true if a layer above \p layer covers (x, y).
+    bool is_covered(std::size_t layer, std::size_t x, std::size_t y) const;
+
+    /// Shift the rows of \p rect in \p cache, \p origin is the cache's (0, 0).
+    static void shift_cache(Glyph_matrix& cache,
+                            Point origin,
+                            const Rect& rect,
+                            int rows);
+
+    /// Write the cached tile of the top-most layer at (x, y) to the terminal.
+    void restore(std::size_t x, std::size_t y) const;
+};
+
+}  // namespace detail
+}  // namespace cppurses
+#endif  // CPPURSES_PAINTER_DETAIL_LAYERS_HPP
@@ -0,0 +1,56 @@
+#ifndef CPPURSES_PAINTER_DETAIL_OFFSCREEN_HOST_HPP
+#define CPPURSES_PAINTER_DETAIL_OFFSCREEN_HOST_HPP
+#include <unordered_map>
+
+#include <cppurses/painter/detail/screen_descriptor.hpp>
+#include <cppurses/widget/point.hpp>
+
+namespace cppurses {
+class Widget;
+namespace detail {
+
+/// Base for Widgets that composite the painting of their descendants.
+/** Descendants of a host are laid out in virtual coordinates, which are global
+ *  coordinates as if the host had unlimited space. On flush, the tiles staged
+ *  by each descendant are handed to the nearest host instead of the Screen,
+ *  and the host is sent a Paint_event to display whatever is visible. A
+ *  virtual Point is displayed at that Point minus scroll_offset(), if it
+ *  falls within the host's inner area. */
+class Offscreen_host {
+   public:
+    Offscreen_host(const Offscreen_host&) = delete;
+    Offscreen_host& operator=(const Offscreen_host&) = delete;
+
+    /// Take \p tiles, everything \p descendant painted, in virtual coordinates.
+    virtual void receive(Widget& descendant, const Screen_descriptor& tiles) = 0;
+
+    /// Return the distance from virtual coordinates to screen coordinates.
+    virtual Point scroll_offset() const = 0;
+
+    /// Return the Widget this object was constructed with.
+    Widget& widget() const { return self_; }
+
+    /// Return the nearest host that \p widg is a descendant of, or nullptr.
+    static Offscreen_host* find(const Widget& widg);
+
+    /// Return \p widg as a host if it is one, otherwise nullptr.
+    static Offscreen_host* as_host(const Widget& widg);
+
+    /// Translate \p position, painted by \p widg, into screen coordinates.
+    /** Returns false if \p position is scrolled out of view of any host. */
+    static bool to_screen(const Widget& widg, Point& position);
+
+   protected:
+    /// Register \p self, the Widget inheriting from this, as a host.
+    explicit Offscreen_host(Widget& self);
+    ~Offscreen_host();
+
+   private:
+    Widget& self_;
+
+    static std::unordered_map<const Widget*, Offscreen_host*>& registry();
+};
+
+}  // namespace detail
+}  // namespace cppurses
+#endif  // CPPURSES_PAINTER_DETAIL_OFFSCREEN_HOST_HPP
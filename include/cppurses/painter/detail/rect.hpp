@@ -0,0 +1,35 @@
+#ifndef CPPURSES_PAINTER_DETAIL_RECT_HPP
+#define CPPURSES_PAINTER_DETAIL_RECT_HPP
+#include <cstddef>
+
+#include <cppurses/widget/area.hpp>
+#include <cppurses/widget/point.hpp>
+
+namespace cppurses {
+namespace detail {
+
+/// A rectangle of screen cells, \p position is the top left.
+struct Rect {
+    Point position;
+    Area size;
+
+    /// Return true if (x, y) is within the rectangle.
+    bool contains(std::size_t x, std::size_t y) const
+    {
+        return x >= position.x && x < position.x + size.width &&
+               y >= position.y && y < position.y + size.height;
+    }
+
+    /// Return true if \p other shares at least one cell with this.
+    bool intersects(const Rect& other) const
+    {
+        return position.x < other.position.x + other.size.width &&
+               other.position.x < position.x + size.width &&
+               position.y < other.position.y + other.size.height &&
+               other.position.y < position.y + size.height;
+    }
+};
+
+}  // namespace detail
+}  // namespace cppurses
+#endif  // CPPURSES_PAINTER_DETAIL_RECT_HPP
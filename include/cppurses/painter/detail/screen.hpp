@@ -1,5 +1,7 @@
 #ifndef CPPURSES_PAINTER_DETAIL_SCREEN_HPP
 #define CPPURSES_PAINTER_DETAIL_SCREEN_HPP
+#include <cstddef>
+
 #include <cppurses/painter/detail/screen_descriptor.hpp>
 #include <cppurses/painter/detail/staged_changes.hpp>
 
@@ -22,6 +24,16 @@ class Screen {
     static void set_cursor_on_focus_widget();
 
    private:
+    /// Hand tiles staged by descendants of Offscreen_hosts to their host.
+    /** Each host that received tiles is sent a Paint_event immediately. */
+    static void send_to_hosts(const Staged_changes::Map_t& changes);
+
+    /// Return what \p widg looks like with \p staged_tiles applied.
+    /** Only differs from \p staged_tiles if they are changes to what is on
+     *  screen, see Painter::keep_previous(). */
+    static Screen_descriptor complete(const Widget& widg,
+                                      const Screen_descriptor& staged_tiles);
+
     /// Covers space unowned by any child widget with wallpaper.
     /** Does nothing if w has no children. */
     static void paint_empty_tiles(const Widget& widg);
@@ -32,17 +44,20 @@ class Screen {
                                 const Screen_descriptor& staged_tiles);
 
     // Performs a full paint of a single tile at \p point.
-    // Paints either a wallpaper or staged change tile, unless the staged tile
-    // is the same as what is currently on screen.
+    // Paints either \p wallpaper or staged change tile, unless the staged tile
+    // is the same as what is currently on screen. \p layer is from Layers.
     static void full_paint_single_point(Widget& widg,
                                         const Screen_descriptor& staged_tiles,
-                                        const Point& point);
+                                        const Point& point,
+                                        std::size_t layer,
+                                        const Glyph& wallpaper);
 
     // Performs a basic paint of a single \p point.
     // Only paints if the staged change tile is different from what is onscreen.
     static void basic_paint_single_point(Widget& widg,
                                          const Point& point,
-                                         Glyph tile);
+                                         Glyph tile,
+                                         std::size_t layer);
 
     // Paint every point of \p widg with wallpaper or from \p staged_tiles.
     static void full_paint(Widget& widg, const Screen_descriptor& staged_tiles);
@@ -59,14 +74,24 @@ class Screen {
     static void paint_child_event(Widget& widg,
                                   const Screen_descriptor& staged_tiles);
 
-    // Paint tiles based on a Screen_mask created by Resize_event::send();
+    // Full paint of the space exposed by Resize_event::send(), basic elsewhere.
     static void paint_resize_event(Widget& widg,
                                    const Screen_descriptor& staged_tiles);
 
-    // TODO Implement with optimizations, currently performs full repaint.
+    // Shift what is on screen by optimize.scrolled rows, then a basic paint.
+    static void paint_scroll(Widget& widg,
+                             const Screen_descriptor& staged_tiles);
+
+    // Paint every point of \p widg, skipping those already on the screen.
+    // The staged tiles of a moved Widget are what it painted before the move.
     static void paint_move_event(Widget& widg,
                                  const Screen_descriptor& staged_tiles);
 
+    // Apply \p staged_tiles and the erased tiles, leave the rest as it is.
+    // Used when only changes were staged, see Painter::keep_previous().
+    static void paint_partial(Widget& widg,
+                              const Screen_descriptor& staged_tiles);
+
     // Call on the correct optimizing function to paint.
     static void delegate_paint(Widget& widg,
                                const Screen_descriptor& staged_tiles);
@@ -1,8 +1,12 @@
 #ifndef CPPURSES_PAINTER_DETAIL_SCREEN_STATE_HPP
 #define CPPURSES_PAINTER_DETAIL_SCREEN_STATE_HPP
+#include <unordered_set>
+#include <vector>
+
+#include <cppurses/painter/detail/rect.hpp>
 #include <cppurses/painter/detail/screen_descriptor.hpp>
-#include <cppurses/painter/detail/screen_mask.hpp>
 #include <cppurses/painter/glyph.hpp>
+#include <cppurses/widget/point.hpp>
 
 namespace cppurses {
 namespace layout {
@@ -12,7 +16,11 @@ class Enable_event;
 class Disable_event;
 class Child_event;
 class Move_event;
+class Paint_event;
+class Painter;
 class Resize_event;
+class Scroll_area;
+class Text_display;
 namespace detail {
 
 /// Holds a Screen_descriptor representing the current screen state of a Widget.
@@ -25,9 +33,11 @@ class Screen_state {
         bool moved{false};
         bool resized{false};
         bool child_event{false};
+        int scrolled{0};  // Rows the inner area's content has moved up.
         Glyph wallpaper;  // previous wallpaper
-        detail::Screen_mask move_mask;
-        detail::Screen_mask resize_mask;
+        std::vector<Rect> resize_mask;  // Exposed since the last flush.
+        bool partial{false};  // Staged tiles only change what is on screen.
+        std::unordered_set<Point> erased;  // Back to wallpaper, if partial.
 
         /// Reset all flags to initial and clear state, except for wallpaper.
         void reset();
@@ -46,7 +56,11 @@ class Screen_state {
     friend class cppurses::Disable_event;
     friend class cppurses::Child_event;
     friend class cppurses::Move_event;
+    friend class cppurses::Paint_event;
+    friend class cppurses::Painter;
     friend class cppurses::Resize_event;
+    friend class cppurses::Scroll_area;
+    friend class cppurses::Text_display;
 };
 
 }  // namespace detail
@@ -0,0 +1,149 @@
+#ifndef CPPURSES_PAINTER_GLYPH_FILE_HPP
+#define CPPURSES_PAINTER_GLYPH_FILE_HPP
+#include <algorithm>
+#include <cstddef>
+#include <cstdint>
+#include <ostream>
+#include <unordered_map>
+#include <vector>
+
+#include <cppurses/painter/brush.hpp>
+#include <cppurses/painter/glyph.hpp>
+#include <cppurses/painter/glyph_matrix.hpp>
+
+namespace cppurses {
+
+/// Read only view of Glyphs stored in the binary glyph file format.
+/** All integers are little endian, every record is 4 byte aligned:
+ *  - Header, 24 bytes: "CPGF", u16 version, u16 reserved, u32 width,
+ *    u32 height, u32 palette size, u32 run count.
+ *  - Palette, 4 bytes per distinct Brush: u8 Attribute bits, u8 color flags
+ *    (1 if a background is set, 2 if a foreground), u8 background color,
+ *    u8 foreground color.
+ *  - Runs, 12 bytes each: u32 symbol, u16 palette index, u16 reserved,
+ *    u32 length.
+ *
+ *  Runs cover the width x height cells in row-major order and may wrap past
+ *  the end of a row. Cells with palette index Glyph_file::empty hold no Glyph.
+ *  The file can be viewed straight from a Mapped_file, nothing is copied but
+ *  the palette, so the data must outlive the view. */
+class Glyph_file {
+   public:
+    /// Format version written, and the only version read.
+    static constexpr std::uint16_t version{1};
+
+    /// Palette index of cells that hold no Glyph.
+    static constexpr std::uint16_t empty{0xFFFF};
+
+    /// Largest area read, in cells, 16M Glyphs make a 128MB Glyph_matrix.
+    static constexpr std::uint64_t max_cells{std::uint64_t{1} << 24};
+
+    /// Return true if \p data starts with the glyph file signature.
+    static bool has_signature(const char* data, std::size_t size);
+
+    /// View the \p size bytes at \p data.
+    /** Throws std::runtime_error if the data is truncated, is of another
+     *  version, its area is larger than max_cells or its runs do not cover
+     *  exactly width x height cells. */
+    Glyph_file(const char* data, std::size_t size);
+
+    /// Return the width of the stored area, in cells.
+    std::size_t width() const { return width_; }
+
+    /// Return the height of the stored area, in cells.
+    std::size_t height() const { return height_; }
+
+    /// Call visit(x, y, length, glyph) for each run of non-empty cells.
+    /** Runs are split at the end of each row, so a run covers the cells
+     *  [x, x + length) of row y. Runs are visited in row-major order. */
+    template <typename Function>
+    void for_each_run(Function&& visit) const;
+
+    /// Return the stored Glyphs as a Glyph_matrix, empty cells are spaces.
+    Glyph_matrix to_matrix() const;
+
+   private:
+    struct Run {
+        wchar_t symbol;
+        std::uint16_t style;
+        std::size_t length;
+    };
+
+    std::size_t width_;
+    std::size_t height_;
+    std::vector<Brush> palette_;
+    const char* runs_;
+    std::size_t run_count_;
+
+    /// Decode the run at \p index.
+    Run run(std::size_t index) const;
+};
+
+/// Builds a glyph file from Glyphs appended in row-major order.
+/** Consecutive equal Glyphs are merged into a single run, and each distinct
+ *  Brush is stored once in the palette. */
+class Glyph_file_writer {
+   public:
+    /// Start an area of \p width x \p height cells, all empty.
+    Glyph_file_writer(std::size_t width, std::size_t height);
+
+    /// Append \p count copies of \p glyph after the last appended cell.
+    /** Throws std::length_error past 65535 distinct Brushes. */
+    void append(const Glyph& glyph, std::size_t count = 1);
+
+    /// Append \p count cells that hold no Glyph.
+    void skip(std::size_t count);
+
+    /// Write the file to \p os, cells past the last appended are empty.
+    void write(std::ostream& os) const;
+
+   private:
+    struct Run {
+        std::uint32_t symbol;
+        std::uint16_t style;
+        std::uint32_t length;
+    };
+
+    std::size_t width_;
+    std::size_t height_;
+    std::size_t cell_count_{0};
+    std::vector<std::uint32_t> palette_;
+    std::unordered_map<std::uint32_t, std::uint16_t> palette_index_;
+    // Brush of the last appended Glyph, most runs share their neighbor's.
+    Brush last_brush_;
+    std::uint16_t last_style_{0};
+    std::vector<Run> runs_;
+
+    /// Add \p count cells of the given symbol and palette index.
+    void add_run(std::uint32_t symbol, std::uint16_t style, std::size_t count);
+};
+
+/// Write each Glyph of \p matrix to \p os in the glyph file format.
+void write_glyph_file(std::ostream& os, const Glyph_matrix& matrix);
+
+template <typename Function>
+void Glyph_file::for_each_run(Function&& visit) const {
+    std::size_t x{0};
+    std::size_t y{0};
+    for (std::size_t i{0}; i < run_count_; ++i) {
+        const Run r{this->run(i)};
+        const Glyph glyph{r.style == empty ? Glyph{}
+                                           : Glyph{r.symbol, palette_[r.style]}};
+        std::size_t remaining{r.length};
+        while (remaining != 0) {
+            const std::size_t length{std::min(remaining, width_ - x)};
+            if (r.style != empty) {
+                visit(x, y, length, glyph);
+            }
+            remaining -= length;
+            x += length;
+            if (x == width_) {
+                x = 0;
+                ++y;
+            }
+        }
+    }
+}
+
+}  // namespace cppurses
+#endif  // CPPURSES_PAINTER_GLYPH_FILE_HPP
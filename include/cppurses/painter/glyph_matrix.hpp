@@ -1,6 +1,7 @@
 #ifndef CPPURSES_PAINTER_GLYPH_MATRIX_HPP
 #define CPPURSES_PAINTER_GLYPH_MATRIX_HPP
 #include <cstddef>
+#include <stdexcept>
 #include <vector>
 
 #include <cppurses/painter/glyph.hpp>
@@ -8,51 +9,84 @@
 namespace cppurses {
 
 /// Holds a matrix of Glyphs, provides simple access by indices.
+/** Glyphs are stored contiguously in row-major order, each row is stride()
+ *  Glyphs long, so a full row can be accessed as a single span. */
 class Glyph_matrix {
    public:
     /// Construct with a set width and height, or defaults to 0 for each.
     /** Glyphs default constructed(space char with no colors or attributes). */
     explicit Glyph_matrix(std::size_t width = 0, std::size_t height = 0)
-        : matrix_{height, std::vector<Glyph>(width, Glyph{L' '})} {}
+        : width_{width},
+          height_{height},
+          glyphs_(width * height, Glyph{L' '}) {}
 
     /// Resize the width and height of the matrix.
     /** New Glyphs will be default constructed, Glyphs no longer within the
-     *  bounds of the matrix will be destructed. */
+     *  bounds of the matrix will be destructed. Existing Glyphs keep their
+     *  (x, y) position. */
     void resize(std::size_t width, std::size_t height);
 
     /// Remove all Glyphs from the matrix and set width/height to 0.
-    void clear() { matrix_.clear(); }
+    void clear() {
+        glyphs_.clear();
+        width_ = 0;
+        height_ = 0;
+    }
 
     /// Return the width of the matrix.
-    std::size_t width() const {
-        return matrix_.empty() ? 0 : matrix_.at(0).size();
-    }
+    std::size_t width() const { return width_; }
 
     /// Return the height of the matrix.
-    std::size_t height() const { return matrix_.size(); }
+    std::size_t height() const { return height_; }
+
+    /// Return the distance, in Glyphs, between the start of adjacent rows.
+    std::size_t stride() const { return width_; }
+
+    /// Return a pointer to the first Glyph of row \p y.
+    /** The row is width() Glyphs long. Provides no bounds checking. */
+    Glyph* row(std::size_t y) { return glyphs_.data() + y * this->stride(); }
+
+    /// Return a pointer to the first Glyph of row \p y.
+    /** The row is width() Glyphs long. Provides no bounds checking. */
+    const Glyph* row(std::size_t y) const {
+        return glyphs_.data() + y * this->stride();
+    }
 
     /// Glyph access operator. (0, 0) is top left. x grows south and y east.
     /** Provides no bounds checking. */
-    Glyph& operator()(std::size_t x, std::size_t y) { return matrix_[y][x]; }
+    Glyph& operator()(std::size_t x, std::size_t y) { return this->row(y)[x]; }
 
     /// Glyph access operator. (0, 0) is top left. x grows south and y east.
     /** Provides no bounds checking. */
     const Glyph& operator()(std::size_t x, std::size_t y) const {
-        return matrix_[y][x];
+        return this->row(y)[x];
     }
 
     /// Glyph access operator. (0, 0) is top left. x grows south and y east.
     /** Has bounds checking and throws std::out_of_range if not within range. */
-    Glyph& at(std::size_t x, std::size_t y) { return matrix_.at(y).at(x); }
+    Glyph& at(std::size_t x, std::size_t y) {
+        this->check_bounds(x, y);
+        return (*this)(x, y);
+    }
 
     /// Glyph access operator. (0, 0) is top left. x grows south and y east.
     /** Has bounds checking and throws std::out_of_range if not within range. */
     const Glyph& at(std::size_t x, std::size_t y) const {
-        return matrix_.at(y).at(x);
+        this->check_bounds(x, y);
+        return (*this)(x, y);
     }
 
    private:
-    std::vector<std::vector<Glyph>> matrix_;
+    std::size_t width_;
+    std::size_t height_;
+    std::vector<Glyph> glyphs_;
+
+    /// Throw std::out_of_range if (x, y) is not within the matrix.
+    void check_bounds(std::size_t x, std::size_t y) const {
+        if (x >= width_ || y >= height_) {
+            throw std::out_of_range{"Glyph_matrix::at: index out of range."};
+        }
+    }
 };
 
 }  // namespace cppurses
@@ -57,7 +57,10 @@ class Glyph_string : private std::vector<Glyph> {
     Glyph_string(const std::initializer_list<Glyph>& glyphs,
                  Attributes&&... attrs);
 
+    Glyph_string(const Glyph_string&) = default;
+    Glyph_string(Glyph_string&&) noexcept = default;
     Glyph_string& operator=(const Glyph_string&) = default;
+    Glyph_string& operator=(Glyph_string&&) noexcept = default;
 
     /// Convert to a std::string, each Glyph being a char.
     std::string str() const { return utility::wchar_to_bytes(this->w_str()); }
@@ -1,14 +1,18 @@
 #ifndef CPPURSES_PAINTER_PAINTER_HPP
 #define CPPURSES_PAINTER_PAINTER_HPP
 #include <cstddef>
+#include <unordered_set>
+#include <vector>
 
 #include <cppurses/painter/detail/screen_descriptor.hpp>
 #include <cppurses/painter/detail/staged_changes.hpp>
 #include <cppurses/widget/area.hpp>
+#include <cppurses/widget/border.hpp>
+#include <cppurses/widget/point.hpp>
 
 namespace cppurses {
+class Glyph_matrix;
 class Glyph_string;
-struct Point;
 struct Glyph;
 class Widget;
 
@@ -38,6 +42,14 @@ class Painter {
         this->put(text, position.x, position.y);
     }
 
+    /// Copy the visible part of \p matrix to local coordinates \p position.
+    /** \p offset is the Glyph in \p matrix that is placed at \p position.
+     *  Clipped to the Widget's inner area, each row is copied as a span of
+     *  Glyphs. No-op if \p offset is outside of \p matrix. */
+    void blit(const Glyph_matrix& matrix,
+              Point offset   = Point{0, 0},
+              Point position = Point{0, 0});
+
     /// Paint the Border object around the outside of the associated Widget.
     /** Borders own the perimeter defined by Widget::x(), Widget::y() and
      *  Widget::outer_width(), Widget::outer_height(). Border is owned by
@@ -73,8 +85,33 @@ class Painter {
         this->line(tile, a.x, a.y, b.x, b.y);
     }
 
+    /// Keep what is on screen, this paint_event only stages changes to it.
+    /** Tiles that are not put by this paint_event are left as they are,
+     *  instead of being returned to the wallpaper, erase() does that. The
+     *  Widget must still paint in full when the changes would not apply, such
+     *  as after being enabled or resized. */
+    void keep_previous();
+
+    /// Return the tile at local coordinates to the wallpaper.
+    /** For use with keep_previous(), no-op if out of Widget's bounds. */
+    void erase(std::size_t x, std::size_t y);
+
+    /// Return the tile at local coordinates \p position to the wallpaper.
+    /** For use with keep_previous(), no-op if out of Widget's bounds. */
+    void erase(const Point& position) { this->erase(position.x, position.y); }
+
+    class Region;
+
+    /// Return a Region covering the whole inner area of the Widget.
+    Region region();
+
+    /// Return a Region of \p size with its top left at local \p position.
+    /** The Region is clipped to the Widget's inner area, it is empty if
+     *  \p position is outside of it or if the Widget is not paintable. */
+    Region region(Point position, Area size);
+
    private:
-    const Widget& widget_;
+    Widget& widget_;
     const Area inner_area_;
     const bool is_paintable_;
 
@@ -96,19 +133,78 @@ class Painter {
         this->put_global(tile, position.x, position.y);
     }
 
-    /// Paint a line from [x1, y1] to [x2, y2] using global coordinates.
-    /** No bounds checking, used internally for Border object painting. */
-    void line_global(const Glyph& tile,
-                     std::size_t x1,
-                     std::size_t y1,
-                     std::size_t x2,
-                     std::size_t y2);
-
-    /// Paint a line from \p a to \p b inclusive using global coordinates.
-    /** No bounds checking, used internally for Border object painting. */
-    void line_global(const Glyph& tile, const Point& a, const Point& b) {
-        line_global(tile, a.x, a.y, b.x, b.y);
+    /// Record the Border of widget_ as spans, in painting order.
+    /** Spans are local to the Widget's top left, including the Border. */
+    void render_border(std::vector<Border::Span>& spans) const;
+};
+
+/// Unchecked painting within a rectangle of a Widget, for hot loops.
+/** The position of the rectangle on the screen and its clipped size are
+ *  computed once, by Painter::region(), instead of on every Painter::put().
+ *  Coordinates are local to the Region and are not bounds checked, the
+ *  caller checks against width() and height() once, outside of its loops.
+ *  The Region must not outlive the Painter it came from. */
+class Painter::Region {
+   public:
+    /// Return the width of the Region, after clipping.
+    std::size_t width() const { return size_.width; }
+
+    /// Return the height of the Region, after clipping.
+    std::size_t height() const { return size_.height; }
+
+    /// Return true if there is no cell to paint.
+    bool empty() const { return size_.width == 0 || size_.height == 0; }
+
+    /// Put \p tile at (\p x, \p y), both must be within the Region.
+    void put(const Glyph& tile, std::size_t x, std::size_t y) {
+        staged_changes_[Point{origin_.x + x, origin_.y + y}] = tile;
+    }
+
+    /// Put \p tile at \p position, which must be within the Region.
+    void put(const Glyph& tile, const Point& position) {
+        this->put(tile, position.x, position.y);
     }
+
+    /// Return the tile at (\p x, \p y) to the wallpaper, for keep_previous().
+    /** Both coordinates must be within the Region. */
+    void erase(std::size_t x, std::size_t y) {
+        const Point global{origin_.x + x, origin_.y + y};
+        staged_changes_.erase(global);
+        erased_.insert(global);
+    }
+
+    /// Return the tile at \p position to the wallpaper, for keep_previous().
+    /** \p position must be within the Region. */
+    void erase(const Point& position) { this->erase(position.x, position.y); }
+
+    /// Put glyph_at(x, y) at every cell of the Region, row by row.
+    template <typename Function>
+    void generate(Function&& glyph_at) {
+        staged_changes_.reserve(staged_changes_.size() +
+                                size_.width * size_.height);
+        for (std::size_t y{0}; y < size_.height; ++y) {
+            for (std::size_t x{0}; x < size_.width; ++x) {
+                this->put(glyph_at(x, y), x, y);
+            }
+        }
+    }
+
+   private:
+    Region(detail::Screen_descriptor& staged_changes,
+           std::unordered_set<Point>& erased,
+           Point origin,
+           Area size)
+        : staged_changes_{staged_changes},
+          erased_{erased},
+          origin_{origin},
+          size_{size} {}
+
+    detail::Screen_descriptor& staged_changes_;
+    std::unordered_set<Point>& erased_;
+    const Point origin_;  // Global coordinates of the top left.
+    const Area size_;
+
+    friend class Painter;
 };
 
 }  // namespace cppurses
@@ -1,6 +1,8 @@
 #ifndef CPPURSES_SYSTEM_DETAIL_EVENT_ENGINE_HPP
 #define CPPURSES_SYSTEM_DETAIL_EVENT_ENGINE_HPP
 #include <atomic>
+#include <chrono>
+#include <cstddef>
 #include <memory>
 
 #include <cppurses/painter/detail/screen.hpp>
@@ -13,19 +15,66 @@ namespace cppurses {
 namespace detail {
 
 /// Orchestrates all event processing and queueing.
+/** Events are invoked as soon as they are processed, but the changes they
+ *  stage are flushed to the screen at most once per frame. Frames start at
+ *  whole multiples of the frame period from a single clock, so input and any
+ *  number of animations within the same frame share one flush. */
 class Event_engine {
+   public:
+    using Clock_t = std::chrono::steady_clock;
+
+   private:
     Event_queue queue_;
     std::atomic<bool> notified_{false};  // Whether should process events/flush
 
+    Clock_t::duration frame_period_{std::chrono::microseconds{16667}};
+    const Clock_t::time_point epoch_{Clock_t::now()};
+    Clock_t::time_point next_frame_{epoch_};
+    bool frame_pending_{false};  // Events were invoked since the last flush.
+
    public:
     /// Event_loop uses this to let main thread know it should process events.
     auto notify() -> void { notified_ = true; }
 
-    /// Invokes events and flush the screen.
+    /// Invokes events and flush the screen if a frame is due.
     auto process() -> void
     {
-        invoke_events(queue_);
+        if (invoke_events(queue_))
+            frame_pending_ = true;
+        if (!frame_pending_)
+            return;
+        const auto now = Clock_t::now();
+        if (now < next_frame_)
+            return;
         flush_screen();
+        frame_pending_ = false;
+        if (frame_period_ != Clock_t::duration::zero())
+            next_frame_ = now + frame_period_ - (now - epoch_) % frame_period_;
+    }
+
+    /// Set the most frames flushed to the screen per second, 0 for no limit.
+    auto set_frame_rate(std::size_t fps) -> void
+    {
+        using namespace std::chrono;
+        frame_period_ = fps == 0 ? Clock_t::duration::zero()
+                                 : duration_cast<Clock_t::duration>(
+                                       duration<double>{1.0 / fps});
+        next_frame_ = epoch_;
+    }
+
+    /// Return how long until a waiting frame can be flushed, rounded up.
+    /** Returns zero if it is due, and milliseconds::max() if no events have
+     *  been invoked since the last flush. */
+    auto time_to_next_frame() const -> std::chrono::milliseconds
+    {
+        using namespace std::chrono;
+        if (!frame_pending_)
+            return milliseconds::max();
+        const auto now = Clock_t::now();
+        if (now >= next_frame_)
+            return milliseconds::zero();
+        const auto wait = duration_cast<milliseconds>(next_frame_ - now);
+        return wait < next_frame_ - now ? wait + milliseconds{1} : wait;
     }
 
     /// Return a reference to the internal Event_queue.
@@ -51,34 +100,44 @@ class Event_engine {
     }
 
     /// Send all \p type events in queue to their Widgets.
+    /** Return true if any event was sent. */
     template <Event::Type filter>
-    static auto send_all(Event_queue& queue) -> void
+    static auto send_all(Event_queue& queue) -> bool
     {
         using Event_ptr = std::unique_ptr<Event>;
+        auto sent = false;
         for (Event_ptr event : Event_queue::View<filter>{queue}) {
             System::send_event(*event);
+            sent = true;
         }
+        return sent;
     }
 
     /// Send all delete events to their Widgets.
-    /** Removes any events to the receiver if another thread posted them. */
-    static auto send_all_deletes(Event_queue& queue) -> void
+    /** Removes any events to the receiver if another thread posted them.
+     *  Return true if any event was sent. */
+    static auto send_all_deletes(Event_queue& queue) -> bool
     {
         auto view = Event_queue::View<Event::Delete>{queue};
+        auto sent = false;
         for (std::unique_ptr<Event> event : view) {
             Widget* receiver = &(event->receiver());
             System::send_event(*event);
             queue.remove_events_of(receiver);
+            sent = true;
         }
+        return sent;
     }
 
     /// Sends each event in \p queue to its receiver to be processed.
-    static auto invoke_events(Event_queue& queue) -> void
+    /** Return true if any event was sent. */
+    static auto invoke_events(Event_queue& queue) -> bool
     {
-        send_all<Event::None>(queue);
-        send_all<Event::Paint>(queue);
-        send_all_deletes(queue);
+        auto sent = send_all<Event::None>(queue);
+        sent      = send_all<Event::Paint>(queue) || sent;
+        sent      = send_all_deletes(queue) || sent;
         queue.clean();
+        return sent;
     }
 };
 
@@ -10,8 +10,11 @@ namespace detail {
 /** Return nullptr on failing to find a Widget with the provided coordinates.
  *  Return the deepest child Widget that owns the coordinates. If a parent owns
  *  the coordinates, it is checked if any of the children own it as well before
- *  returning. Used only by input::get at the moment. */
-Widget* find_widget_at(std::size_t x, std::size_t y);
+ *  returning. Open overlays are searched before the head Widget's tree. Within
+ *  a scrolled Offscreen_host, \p x and \p y are updated to the virtual
+ *  coordinates of the returned Widget. Used only by input::get at the moment.
+ */
+Widget* find_widget_at(std::size_t& x, std::size_t& y);
 
 }  // namespace detail
 }  // namespace cppurses
@@ -29,6 +29,14 @@ class Timer_event_loop : public Event_loop {
         : period_func_{period_func}
     {}
 
+    /// Stop the loop thread while loop_function() can still be called.
+    /** Event_loop's destructor runs after this part of the object is gone. */
+    ~Timer_event_loop() override
+    {
+        this->exit(0);
+        this->wait();
+    }
+
     /// Register a widget to have a Timer_event posted to it every period.
     /** No-op if widget is already registered. */
     void register_widget(Widget& w);
@@ -55,6 +55,9 @@ class Event_loop {
     bool is_main_thread_{false};
 
    private:
+    /// Call loop_function() until exit() is called, return the exit code.
+    auto loop() -> int;
+
     /// Connect to the System::exit_signal so loop can exit with System.
     auto connect_to_system_exit() -> void;
 
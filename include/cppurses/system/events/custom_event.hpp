@@ -0,0 +1,34 @@
+#ifndef CPPURSES_SYSTEM_EVENTS_CUSTOM_EVENT_HPP
+#define CPPURSES_SYSTEM_EVENTS_CUSTOM_EVENT_HPP
+#include <functional>
+#include <utility>
+
+#include <cppurses/system/event.hpp>
+
+namespace cppurses {
+class Widget;
+
+/// Runs a function on the main thread when the Event is processed.
+/** Used by worker threads to hand results back to a Widget, the function is
+ *  called from the thread that processes the Event_queue. Not sent if the
+ *  receiver is disabled at that time. */
+class Custom_event : public Event {
+   public:
+    Custom_event(Widget& receiver, std::function<void()> action)
+        : Event{Event::Custom, receiver}, action_{std::move(action)}
+    {}
+
+    bool send() const override
+    {
+        action_();
+        return true;
+    }
+
+    bool filter_send(Widget& /* filter */) const override { return false; }
+
+   private:
+    std::function<void()> action_;
+};
+
+}  // namespace cppurses
+#endif  // CPPURSES_SYSTEM_EVENTS_CUSTOM_EVENT_HPP
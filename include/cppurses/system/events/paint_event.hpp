@@ -1,6 +1,5 @@
 #ifndef CPPURSES_SYSTEM_EVENTS_PAINT_EVENT_HPP
 #define CPPURSES_SYSTEM_EVENTS_PAINT_EVENT_HPP
-#include <cppurses/painter/detail/is_paintable.hpp>
 #include <cppurses/system/event.hpp>
 #include <cppurses/widget/widget.hpp>
 
@@ -11,10 +10,11 @@ class Paint_event : public Event {
    public:
     explicit Paint_event(Widget& receiver) : Event{Event::Paint, receiver} {}
 
-    bool send() const override {
-        return !detail::is_paintable(receiver_) ? false
-                                                : receiver_.paint_event();
-    }
+    /// A paint_event paints the entire Widget, replacing anything staged.
+    /** Unless it only stages changes, see Painter::keep_previous(), then they
+     *  are applied over what was staged since the last flush. */
+    bool send() const override;
+
     bool filter_send(Widget& filter) const override {
         return filter.paint_event_filter(receiver_);
     }
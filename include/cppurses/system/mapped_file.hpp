@@ -0,0 +1,47 @@
+#ifndef CPPURSES_SYSTEM_MAPPED_FILE_HPP
+#define CPPURSES_SYSTEM_MAPPED_FILE_HPP
+#include <cstddef>
+#include <string>
+
+namespace cppurses {
+
+/// Read only view of a file's contents, mapped into memory.
+/** Pages are read in by the OS as they are first touched, so large files can
+ *  be parsed front to back without being copied into a buffer first. */
+class Mapped_file {
+   public:
+    /// Map \p filename into memory, is_open() is false if that fails.
+    explicit Mapped_file(const std::string& filename);
+
+    Mapped_file(const Mapped_file&) = delete;
+    Mapped_file& operator=(const Mapped_file&) = delete;
+
+    Mapped_file(Mapped_file&& other) noexcept;
+    Mapped_file& operator=(Mapped_file&& other) noexcept;
+
+    /// Unmap the file.
+    ~Mapped_file();
+
+    /// Return true if the file was opened, an empty file has no data().
+    bool is_open() const { return is_open_; }
+
+    /// Return the first byte of the file, nullptr if the file is empty.
+    const char* data() const { return data_; }
+
+    /// Return the size of the file in bytes.
+    std::size_t size() const { return size_; }
+
+    const char* begin() const { return data_; }
+    const char* end() const { return data_ + size_; }
+
+   private:
+    const char* data_{nullptr};
+    std::size_t size_{0};
+    bool is_open_{false};
+
+    /// Unmap the file, if mapped.
+    void unmap();
+};
+
+}  // namespace cppurses
+#endif  // CPPURSES_SYSTEM_MAPPED_FILE_HPP
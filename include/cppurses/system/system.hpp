@@ -1,5 +1,6 @@
 #ifndef CPPURSES_SYSTEM_SYSTEM_HPP
 #define CPPURSES_SYSTEM_SYSTEM_HPP
+#include <cstddef>
 #include <memory>
 #include <mutex>
 #include <utility>
@@ -16,6 +17,8 @@
 namespace cppurses {
 class Animation_engine;
 class Widget;
+struct Area;
+struct Point;
 
 /// Organizes the highest level of the TUI framework.
 /** Constructing an instance of this class initializes the display system.
@@ -39,6 +42,20 @@ class System {
      *  on the screen. */
     static Widget* head() { return head_; }
 
+    /// Display \p overlay above the head Widget, at \p position with \p size.
+    /** \p overlay must not have a parent, it remains owned by the caller and
+     *  is closed automatically on destruction. The last opened overlay is
+     *  displayed on top. Opening an open overlay moves and resizes it. Nothing
+     *  underneath an overlay is repainted when it is moved or closed, covered
+     *  cells are restored from the last state each Widget flushed. */
+    static void open_overlay(Widget& overlay, Point position, Area size);
+
+    /// Move an open \p overlay to the global coordinates \p position.
+    static void move_overlay(Widget& overlay, Point position);
+
+    /// Remove \p overlay from the screen, no-op if it is not open.
+    static void close_overlay(Widget& overlay);
+
     /// Set the Widget to receive focus on run().
     /** Needed because focus has to be set after a widget is enabled. */
     static auto set_initial_focus(Widget* target) -> void
@@ -102,6 +119,12 @@ class System {
      *  this function returns. */
     static void exit(int exit_code = 0);
 
+    /// Set the most times per second changes are flushed to the screen.
+    /** Events are still processed as they arrive, everything they paint
+     *  within the same frame is flushed together. 0 flushes after each
+     *  iteration of the main Event_loop. Default is 60. */
+    static void set_frame_rate(std::size_t fps);
+
     /// Return a reference to the Animation_engine in System.
     /** This manages animation on each of the Widgets that enables it. */
     static Animation_engine& animation_engine() { return animation_engine_; }
@@ -0,0 +1,54 @@
+#ifndef CPPURSES_SYSTEM_THREAD_POOL_HPP
+#define CPPURSES_SYSTEM_THREAD_POOL_HPP
+#include <condition_variable>
+#include <cstddef>
+#include <deque>
+#include <functional>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+namespace cppurses {
+
+/// Fixed set of worker threads that run submitted tasks in FIFO order.
+/** Tasks run off of the main thread and must not touch Widgets directly, post
+ *  a Custom_event to hand results back. Long running tasks should check their
+ *  own cancellation condition, the pool only drops tasks not yet started. A
+ *  pool held as a member should be declared after the members its tasks use,
+ *  so its workers are joined before those members are destroyed. */
+class Thread_pool {
+   public:
+    /// Launch \p thread_count workers, defaults to the hardware concurrency.
+    explicit Thread_pool(std::size_t thread_count = default_thread_count());
+
+    Thread_pool(const Thread_pool&) = delete;
+    Thread_pool& operator=(const Thread_pool&) = delete;
+
+    /// Drop tasks not yet started and wait for running tasks to finish.
+    ~Thread_pool();
+
+    /// Queue \p task to be run by the next free worker.
+    void submit(std::function<void()> task);
+
+    /// Drop all tasks not yet started, running tasks are not affected.
+    void clear();
+
+    /// Return the number of worker threads.
+    std::size_t size() const { return workers_.size(); }
+
+    /// Return the hardware concurrency, or one if it cannot be determined.
+    static std::size_t default_thread_count();
+
+   private:
+    std::vector<std::thread> workers_;
+    std::deque<std::function<void()>> tasks_;
+    std::mutex mtx_;
+    std::condition_variable task_available_;
+    bool stop_{false};
+
+    /// Worker thread loop, runs tasks until stop_ is set.
+    void run();
+};
+
+}  // namespace cppurses
+#endif  // CPPURSES_SYSTEM_THREAD_POOL_HPP
@@ -0,0 +1,144 @@
+#ifndef CPPURSES_SYSTEM_UNDO_STACK_HPP
+#define CPPURSES_SYSTEM_UNDO_STACK_HPP
+#include <cstddef>
+#include <deque>
+#include <utility>
+
+namespace cppurses {
+
+/// History of edits for undo and redo, kept within a memory budget.
+/** Edit_t describes a single, already applied, edit as a delta, the owner of
+ *  the Undo_stack knows how to revert and reapply it. Edit_t must provide:
+ *  - std::size_t bytes() const, the memory held by the edit.
+ *  - bool merge(const Edit_t& next), absorb \p next into this edit if it
+ *    continues it, such as typing the next character, return false if not.
+ *
+ *  The oldest edits are dropped once the history uses more than its byte
+ *  budget. */
+template <typename Edit_t>
+class Undo_stack {
+   public:
+    /// Default memory budget, 16MB.
+    static constexpr std::size_t default_byte_budget{1 << 24};
+
+    /// Create an empty history that holds at most \p byte_budget bytes.
+    explicit Undo_stack(std::size_t byte_budget = default_byte_budget)
+        : byte_budget_{byte_budget} {}
+
+    /// Record an applied \p edit, forgets any edits that could be redone.
+    /** \p edit is merged into the last edit when possible, unless
+     *  break_merge() was called since that edit was recorded. */
+    void push(Edit_t edit);
+
+    /// Keep the next push() from merging into the last recorded edit.
+    void break_merge() { merge_allowed_ = false; }
+
+    /// Return true if there is an edit to undo.
+    bool can_undo() const { return applied_ != 0; }
+
+    /// Return true if there is an edit to redo.
+    bool can_redo() const { return applied_ != edits_.size(); }
+
+    /// Return the most recent applied edit, for the caller to revert.
+    /** It becomes the next edit to redo. Must only be called if can_undo(). */
+    const Edit_t& undo();
+
+    /// Return the most recent undone edit, for the caller to reapply.
+    /** Must only be called if can_redo(). */
+    const Edit_t& redo();
+
+    /// Forget every edit.
+    void clear();
+
+    /// Set the memory budget, dropping the oldest edits to fit within it.
+    void set_byte_budget(std::size_t bytes);
+
+    /// Return the memory budget, in bytes.
+    std::size_t byte_budget() const { return byte_budget_; }
+
+    /// Return the memory held by the recorded edits, in bytes.
+    std::size_t bytes() const { return bytes_; }
+
+   private:
+    std::deque<Edit_t> edits_;
+    std::size_t applied_{0};  // Edits [0, applied_) can be undone.
+    std::size_t bytes_{0};
+    std::size_t byte_budget_;
+    bool merge_allowed_{false};
+
+    /// Drop the oldest edits until the history fits within the budget.
+    void trim();
+};
+
+template <typename Edit_t>
+constexpr std::size_t Undo_stack<Edit_t>::default_byte_budget;
+
+template <typename Edit_t>
+void Undo_stack<Edit_t>::push(Edit_t edit) {
+    while (edits_.size() > applied_) {
+        bytes_ -= edits_.back().bytes();
+        edits_.pop_back();
+    }
+    if (merge_allowed_ && !edits_.empty()) {
+        Edit_t& last = edits_.back();
+        const std::size_t before{last.bytes()};
+        if (last.merge(edit)) {
+            bytes_ = bytes_ - before + last.bytes();
+            this->trim();
+            return;
+        }
+    }
+    bytes_ += edit.bytes();
+    edits_.push_back(std::move(edit));
+    applied_ = edits_.size();
+    merge_allowed_ = true;
+    this->trim();
+}
+
+template <typename Edit_t>
+const Edit_t& Undo_stack<Edit_t>::undo() {
+    merge_allowed_ = false;
+    return edits_[--applied_];
+}
+
+template <typename Edit_t>
+const Edit_t& Undo_stack<Edit_t>::redo() {
+    merge_allowed_ = false;
+    return edits_[applied_++];
+}
+
+template <typename Edit_t>
+void Undo_stack<Edit_t>::clear() {
+    edits_.clear();
+    applied_ = 0;
+    bytes_ = 0;
+    merge_allowed_ = false;
+}
+
+template <typename Edit_t>
+void Undo_stack<Edit_t>::set_byte_budget(std::size_t bytes) {
+    byte_budget_ = bytes;
+    this->trim();
+}
+
+template <typename Edit_t>
+void Undo_stack<Edit_t>::trim() {
+    // Undone edits can only be redone after those before them, so once there
+    // is nothing left to undo the newest are dropped instead.
+    while (bytes_ > byte_budget_ && !edits_.empty()) {
+        if (applied_ == 0) {
+            bytes_ -= edits_.back().bytes();
+            edits_.pop_back();
+        } else {
+            bytes_ -= edits_.front().bytes();
+            edits_.pop_front();
+            --applied_;
+        }
+    }
+    if (edits_.empty()) {
+        merge_allowed_ = false;
+    }
+}
+
+}  // namespace cppurses
+#endif  // CPPURSES_SYSTEM_UNDO_STACK_HPP
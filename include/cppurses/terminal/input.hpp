@@ -1,5 +1,6 @@
 #ifndef CPPURSES_TERMINAL_INPUT_HPP
 #define CPPURSES_TERMINAL_INPUT_HPP
+#include <chrono>
 #include <memory>
 
 namespace cppurses {
@@ -11,6 +12,10 @@ namespace input {
  *  terminal being resized. Will return nullptr if there is an error. */
 auto get() -> std::unique_ptr<Event>;
 
+/// Wait at most \p timeout for user input, and return a corresponding Event.
+/** Returns nullptr if there was no input within \p timeout, or on error. */
+auto get(std::chrono::milliseconds timeout) -> std::unique_ptr<Event>;
+
 }  // namespace input
 }  // namespace cppurses
 #endif  // CPPURSES_TERMINAL_INPUT_HPP
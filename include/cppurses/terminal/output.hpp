@@ -14,6 +14,17 @@ void move_cursor(std::size_t x, std::size_t y);
 /// Flushes all of the changes made since the last refresh to the screen.
 void refresh();
 
+/// Shift the rows of a rectangle of the screen up by \p rows.
+/** Negative \p rows shift down. The rectangle has top left \p x , \p y and
+ *  size \p width x \p height, rows shifted in are blank. Full width shifts
+ *  are sent to the terminal as scroll region operations on refresh. Returns
+ *  false if nothing was shifted. */
+bool shift_rows(std::size_t x,
+                std::size_t y,
+                std::size_t width,
+                std::size_t height,
+                int rows);
+
 /// Places Glyph \p g on the screen at the current cursor position.
 void put(const Glyph& g);
 
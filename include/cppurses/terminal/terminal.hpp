@@ -3,9 +3,12 @@
 #include <chrono>
 #include <cstddef>
 
+#include <cppurses/painter/color.hpp>
+#include <cppurses/painter/color_definition.hpp>
 #include <cppurses/painter/glyph.hpp>
 #include <cppurses/painter/palette.hpp>
 #include <cppurses/painter/palettes.hpp>
+#include <cppurses/painter/rgb.hpp>
 
 namespace cppurses {
 
@@ -27,11 +30,16 @@ class Terminal {
     /// Return the height of the terminal screen.
     std::size_t height() const;
 
-    /// Set the rate at which the screen will update.
-    /** User input will immediately flush, but other event loops are only
-     *  processed every refresh rate. Default is 33ms. */
+    /// Set the longest time the main thread waits for user input.
+    /** Events posted by other event loops are processed after user input or
+     *  once this much time has passed. Changes are flushed to the screen at
+     *  most at the frame rate, see System::set_frame_rate(). Default is 33ms.
+     */
     auto set_refresh_rate(std::chrono::milliseconds duration) -> void;
 
+    /// Return the longest time the main thread waits for user input.
+    std::chrono::milliseconds refresh_rate() const { return refresh_rate_; }
+
     /// Set the default background/wallpaper tiles to be used.
     /** This is used if a Widget has no assigned wallpaper. */
     void set_background(const Glyph& tile);
@@ -40,11 +48,20 @@ class Terminal {
     const Glyph& background() const { return background_; }
 
     /// Set terminal color definitions for the 16 Colors in CPPurses.
+    /** Only the definitions that differ from the current palette are sent to
+     *  the terminal. */
     void set_color_palette(const Palette& colors);
 
+    /// Set the terminal color definition of a single Color.
+    /** No-op if \p definition is already current. */
+    void set_color_definition(const Color_definition& definition);
+
     /// Return a copy of the currently set color palette.
     Palette current_palette() const { return palette_; }
 
+    /// Return the RGB values currently defined for \p color.
+    RGB color_values(Color color) const;
+
     /// Set whether or not the cursor is visible on screen.
     void show_cursor(bool show = true);
 
@@ -90,6 +107,9 @@ class Terminal {
     /// Actually set the palette via ncurses using the state of \p colors.
     void ncurses_set_palette(const Palette& colors);
 
+    /// Actually set a single color definition via ncurses.
+    void ncurses_set_color(const Color_definition& definition);
+
     /// Actually set raw/noraw mode via ncurses using the state of raw_mode_.
     void ncurses_set_raw_mode() const;
 
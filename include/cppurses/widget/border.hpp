@@ -1,8 +1,13 @@
 #ifndef CPPURSES_WIDGET_BORDER_HPP
 #define CPPURSES_WIDGET_BORDER_HPP
+#include <cstddef>
+#include <vector>
+
 #include <cppurses/painter/glyph.hpp>
+#include <cppurses/widget/point.hpp>
 
 namespace cppurses {
+class Painter;
 
 /// Provides representation of a Widget's visible, surrounding border.
 class Border {
@@ -79,6 +84,29 @@ class Border {
 
    private:
     bool enabled_{false};
+
+    /// A run of \p length identical Glyphs, local to the Widget's top left.
+    struct Span {
+        Point start;
+        std::size_t length;
+        bool vertical;
+        Glyph glyph;
+    };
+
+    /// The last rendering of this Border, and what it was rendered from.
+    struct Render_cache {
+        bool valid{false};
+        std::size_t width{0};
+        std::size_t height{0};
+        Segments segments;
+        Glyph wallpaper;
+        std::vector<Span> spans;
+    };
+
+    /// Maintained by Painter::border().
+    mutable Render_cache cache_;
+
+    friend class Painter;
 };
 }  // namespace cppurses
 #endif  // CPPURSES_WIDGET_BORDER_HPP
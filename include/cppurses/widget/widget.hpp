@@ -301,6 +301,7 @@ class Widget {
     virtual bool child_polished_event(Widget& child);
 
     /// Handles Move_event objects.
+    /** Does not repaint, the last painted tiles are moved with the Widget. */
     virtual bool move_event(Point new_position, Point old_position);
 
     /// Handles Resize_event objects.
@@ -0,0 +1,18 @@
+#ifndef CPPURSES_WIDGET_WIDGETS_DETAIL_FUZZY_SCORE_HPP
+#define CPPURSES_WIDGET_WIDGETS_DETAIL_FUZZY_SCORE_HPP
+#include <string>
+
+namespace cppurses {
+namespace detail {
+
+/// Score how well \p candidate matches \p pattern as an ordered subsequence.
+/** \p pattern must already be in lower case, \p candidate is compared case
+ *  insensitively. Returns zero if not every pattern character is found in
+ *  order, otherwise a positive score that favors consecutive characters,
+ *  characters at the start of words, and shorter candidates. An empty pattern
+ *  matches everything with a score of one. */
+int fuzzy_score(const std::string& pattern, const std::string& candidate);
+
+}  // namespace detail
+}  // namespace cppurses
+#endif  // CPPURSES_WIDGET_WIDGETS_DETAIL_FUZZY_SCORE_HPP
@@ -0,0 +1,138 @@
+#ifndef CPPURSES_WIDGET_WIDGETS_FILE_PICKER_HPP
+#define CPPURSES_WIDGET_WIDGETS_FILE_PICKER_HPP
+#include <atomic>
+#include <cstddef>
+#include <ctime>
+#include <map>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <vector>
+
+#include <signals/signal.hpp>
+#include <signals/slot.hpp>
+
+#include <cppurses/painter/glyph_string.hpp>
+#include <cppurses/system/thread_pool.hpp>
+#include <cppurses/widget/layouts/vertical.hpp>
+#include <cppurses/widget/widgets/label.hpp>
+#include <cppurses/widget/widgets/virtual_menu.hpp>
+
+namespace cppurses {
+
+/// Browses the filesystem and sends the path of the file picked.
+/** Directories are read on a worker thread, entries are appended to the list
+ *  in batches as they are read, so large directories or slow mounts do not
+ *  hold up input. The list only paints visible rows and typing filters it,
+ *  see Virtual_menu. Once read, a directory listing is sorted, directories
+ *  first, and cached along with the type of each entry. It is reused while
+ *  the directory's modification time is unchanged, so revisiting a directory
+ *  costs a single stat call. */
+class File_picker : public layout::Vertical {
+   public:
+    /// Start browsing at \p directory.
+    explicit File_picker(std::string directory = ".");
+
+    /// Cancel any running scan and wait for the worker to finish.
+    ~File_picker();
+
+    /// Browse \p directory, the entries are read in the background.
+    void set_directory(std::string directory);
+
+    /// Return the directory being browsed.
+    const std::string& directory() const { return directory_; }
+
+    /// Return true while the directory is still being read.
+    bool scanning() const { return scanning_; }
+
+    /// Set the number of entries read before they are added to the list.
+    /** Entries read so far are also added if reading has taken 50ms since
+     *  the last batch. Default is 512. */
+    void set_batch_size(std::size_t size);
+
+    /// Emitted when a file is picked with Enter or a click, sends its path.
+    sig::Signal<void(const std::string&)> file_picked;
+
+    /// Emitted when the directory browsed changes, sends its path.
+    sig::Signal<void(const std::string&)> directory_changed;
+
+    Label& path_display{this->make_child<Label>()};
+    Virtual_menu& entries{this->make_child<Virtual_menu>()};
+    Label& status{this->make_child<Label>()};
+
+   protected:
+    bool enable_event() override;
+    bool disable_event() override;
+
+   private:
+    struct Entry {
+        std::string name;
+        Glyph_string label;  // Decoded on the worker thread.
+        bool is_directory;
+    };
+
+    using Entries_t = std::vector<Entry>;
+
+    /// A fully read directory, valid while its modification time is the same.
+    struct Listing {
+        std::time_t modified_seconds;
+        long modified_nanoseconds;
+        std::shared_ptr<const Entries_t> entries;
+    };
+
+    std::string directory_;
+    std::size_t batch_size_{512};
+    bool scanning_{false};
+    bool rescan_on_enable_{false};
+
+    // Entries displayed by the list, in the same order as its items.
+    Entries_t shown_;
+    // Name of the entry to select once the sorted listing is shown.
+    std::string reselect_;
+
+    std::atomic<std::size_t> generation_{0};
+
+    // Read and written by the worker, keyed by directory path.
+    std::mutex cache_mtx_;
+    std::map<std::string, Listing> listings_;
+
+    Thread_pool worker_{1};
+
+    /// Worker thread, read \p directory and post its entries in batches.
+    void scan(std::size_t generation,
+              const std::string& directory,
+              std::size_t batch_size);
+
+    /// Have \p batch appended to the list on the main thread.
+    void post_entries(std::size_t generation, Entries_t batch);
+
+    /// Have the sorted \p listing replace the entries shown, main thread.
+    void post_listing(std::size_t generation,
+                      std::shared_ptr<const Entries_t> listing);
+
+    /// Have \p message shown in the status Label and end the scan.
+    void post_error(std::size_t generation, std::string message);
+
+    /// Main thread, append \p batch to the list.
+    void add_entries(std::size_t generation, const Entries_t& batch);
+
+    /// Main thread, show \p listing from index \p first on.
+    /** Posts itself to continue after listing_chunk entries. */
+    void show_listing(std::size_t generation,
+                      std::shared_ptr<const Entries_t> listing,
+                      std::size_t first);
+
+    /// Append \p entry to the list.
+    void show_entry(const Entry& entry);
+
+    /// Open the directory or pick the file at \p index of shown_.
+    void pick(std::size_t index);
+};
+
+namespace slot {
+
+sig::Slot<void(std::string)> set_directory(File_picker& fp);
+
+}  // namespace slot
+}  // namespace cppurses
+#endif  // CPPURSES_WIDGET_WIDGETS_FILE_PICKER_HPP
@@ -0,0 +1,113 @@
+#ifndef CPPURSES_WIDGET_WIDGETS_FUZZY_FINDER_HPP
+#define CPPURSES_WIDGET_WIDGETS_FUZZY_FINDER_HPP
+#include <atomic>
+#include <cstddef>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <vector>
+
+#include <signals/signal.hpp>
+
+#include <cppurses/system/events/key.hpp>
+#include <cppurses/system/thread_pool.hpp>
+#include <cppurses/widget/layouts/vertical.hpp>
+#include <cppurses/widget/widgets/label.hpp>
+#include <cppurses/widget/widgets/line_edit.hpp>
+#include <cppurses/widget/widgets/virtual_menu.hpp>
+
+namespace cppurses {
+
+/// Line_edit over a list of the best fuzzy matches among a set of candidates.
+/** Each edit of the input restarts the search: candidates are scored in
+ *  chunks on a Thread_pool, each chunk keeps its own best results in a heap,
+ *  and finished chunks are merged into the displayed list as they arrive. The
+ *  previous search is cancelled, so the input stays responsive while typing.
+ *  Arrow_up/Arrow_down in the input move the selection, Enter picks it. */
+class Fuzzy_finder : public layout::Vertical {
+   public:
+    Fuzzy_finder();
+
+    /// Cancel any running search and wait for the workers to finish.
+    ~Fuzzy_finder();
+
+    /// Replace the set of strings to search through and restart the search.
+    void set_candidates(std::vector<std::string> candidates);
+
+    /// Return the number of candidates being searched.
+    std::size_t candidate_count() const { return candidates_->size(); }
+
+    /// Set the maximum number of results displayed, default is 100.
+    void set_result_limit(std::size_t limit);
+
+    /// Set the number of candidates scored per task, default is 16,384.
+    void set_chunk_size(std::size_t size);
+
+    /// Return true if a search is still being run on the workers.
+    bool search_pending() const { return pending_; }
+
+    /// Emitted on Enter Key or click, sends the selected candidate.
+    sig::Signal<void(const std::string&)> selected;
+
+    Line_edit& input{this->make_child<Line_edit>()};
+    Label& status{this->make_child<Label>()};
+    Virtual_menu& results{this->make_child<Virtual_menu>()};
+
+   protected:
+    bool key_press_event_filter(Widget& receiver,
+                                const Key::State& keyboard) override;
+    bool enable_event() override;
+
+   private:
+    using Candidates_t = std::vector<std::string>;
+
+    struct Match {
+        int score;
+        std::size_t index;
+    };
+
+    std::shared_ptr<const Candidates_t> candidates_{
+        std::make_shared<Candidates_t>()};
+    std::size_t limit_{100};
+    std::size_t chunk_size_{16'384};
+    std::string pattern_;
+    bool pending_{false};
+
+    // Candidate indices displayed in results, in the order shown.
+    std::vector<std::size_t> shown_;
+
+    std::atomic<std::size_t> generation_{0};
+    std::atomic<bool> refresh_posted_{false};
+
+    // Merged state of the current search, shared with the workers.
+    std::mutex result_mtx_;
+    std::vector<Match> best_;  // Heap with the worst kept Match at the front.
+    std::size_t matched_{0};
+    std::size_t chunks_done_{0};
+    std::size_t chunk_count_{0};
+
+    Thread_pool pool_;
+
+    /// Cancel the current search and start one for \p pattern.
+    void start_search(std::string pattern);
+
+    /// Score candidates [first, last) and merge the best \p limit into best_.
+    void score_chunk(std::size_t generation,
+                     const std::string& pattern,
+                     const Candidates_t& candidates,
+                     std::size_t first,
+                     std::size_t last,
+                     std::size_t limit);
+
+    /// Have refresh_results() called on the main thread, at most once queued.
+    void post_refresh();
+
+    /// Display the merged results found so far.
+    void refresh_results();
+
+    /// Send the selected Signal for the candidate at results row \p row.
+    void send_selected(std::size_t row);
+};
+
+}  // namespace cppurses
+#endif  // CPPURSES_WIDGET_WIDGETS_FUZZY_FINDER_HPP
@@ -3,19 +3,48 @@
 #include <cstddef>
 
 #include <cppurses/painter/glyph_matrix.hpp>
+#include <cppurses/widget/point.hpp>
 #include <cppurses/widget/widget.hpp>
 
 namespace cppurses {
 
+/// Displays a Glyph_matrix, through a viewport that can be scrolled.
+/** If the matrix is larger than the Widget, offset() is the Glyph in the matrix
+ *  that is displayed at the top left of the Widget. */
 class Matrix_display : public Widget {
    public:
     explicit Matrix_display(Glyph_matrix matrix_ = Glyph_matrix{});
     Matrix_display(std::size_t width, std::size_t height);
 
+    /// Set the matrix Glyph that is displayed at the top left of the Widget.
+    /** Clamped so the viewport does not scroll past the end of the matrix. */
+    void set_offset(Point offset);
+
+    /// Return the matrix Glyph that is displayed at the top left of the Widget.
+    Point offset() const { return offset_; }
+
+    /// Scroll the viewport up by \p n rows, stops at the first row.
+    void scroll_up(std::size_t n = 1);
+
+    /// Scroll the viewport down by \p n rows, stops at the last row.
+    void scroll_down(std::size_t n = 1);
+
+    /// Scroll the viewport left by \p n columns, stops at the first column.
+    void scroll_left(std::size_t n = 1);
+
+    /// Scroll the viewport right by \p n columns, stops at the last column.
+    void scroll_right(std::size_t n = 1);
+
     Glyph_matrix matrix;
 
    protected:
     bool paint_event() override;
+
+   private:
+    Point offset_;
+
+    /// Return the largest offset that still fills the Widget with the matrix.
+    Point max_offset() const;
 };
 
 }  // namespace cppurses
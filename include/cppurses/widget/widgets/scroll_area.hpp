@@ -0,0 +1,108 @@
+#ifndef CPPURSES_WIDGET_WIDGETS_SCROLL_AREA_HPP
+#define CPPURSES_WIDGET_WIDGETS_SCROLL_AREA_HPP
+#include <cstddef>
+#include <unordered_map>
+
+#include <signals/connection.hpp>
+
+#include <cppurses/painter/detail/offscreen_host.hpp>
+#include <cppurses/painter/detail/screen_descriptor.hpp>
+#include <cppurses/painter/glyph.hpp>
+#include <cppurses/painter/glyph_matrix.hpp>
+#include <cppurses/system/events/key.hpp>
+#include <cppurses/system/events/mouse.hpp>
+#include <cppurses/widget/area.hpp>
+#include <cppurses/widget/point.hpp>
+#include <cppurses/widget/widget.hpp>
+
+namespace cppurses {
+
+/// Displays a child Widget that can be larger than this, through a viewport.
+/** The first child is the content, it is given its full size from its size
+ *  policies: a Fixed policy gets its hint, a Maximum policy is capped by the
+ *  viewport, anything else gets at least the viewport's length. Additional
+ *  children are disabled. The content and its descendants paint to a cached
+ *  Glyph_matrix, which this Widget copies the visible region of. Scrolling
+ *  only repaints this Widget, the content does not receive Paint_events. The
+ *  viewport scrolls with the arrow keys and the mouse wheel. */
+class Scroll_area : public Widget, private detail::Offscreen_host {
+   public:
+    Scroll_area();
+    ~Scroll_area();
+
+    /// Return the content Widget, or nullptr if there are no children.
+    Widget* content() const;
+
+    /// Set the content Point that is displayed at the top left of the viewport.
+    /** Clamped so the viewport does not scroll past the end of the content. */
+    void set_offset(Point offset);
+
+    /// Return the content Point that is displayed at the top left.
+    Point offset() const { return offset_; }
+
+    /// Scroll the viewport up by \p n rows, stops at the first row.
+    void scroll_up(std::size_t n = 1);
+
+    /// Scroll the viewport down by \p n rows, stops at the last row.
+    void scroll_down(std::size_t n = 1);
+
+    /// Scroll the viewport left by \p n columns, stops at the first column.
+    void scroll_left(std::size_t n = 1);
+
+    /// Scroll the viewport right by \p n columns, stops at the last column.
+    void scroll_right(std::size_t n = 1);
+
+   protected:
+    bool paint_event() override;
+    bool move_event(Point new_position, Point old_position) override;
+    bool resize_event(Area new_size, Area old_size) override;
+    bool child_added_event(Widget& child) override;
+    bool child_polished_event(Widget& child) override;
+    bool mouse_press_event(const Mouse::State& mouse) override;
+    bool key_press_event(const Key::State& keyboard) override;
+
+   private:
+    /// Tiles painted by one descendant, relative to the content's top left.
+    /** Includes the wallpaper of the cells the descendant left empty. */
+    struct Painted {
+        detail::Screen_descriptor tiles;
+        sig::Connection on_destroyed;
+        // Wallpaper of the Widget underneath, shown once the tiles are erased.
+        Glyph underneath;
+    };
+
+    Point offset_;
+    Glyph_matrix canvas_;
+    std::unordered_map<Widget*, Painted> painted_;
+
+    void receive(Widget& descendant,
+                 const detail::Screen_descriptor& tiles) override;
+
+    Point scroll_offset() const override { return offset_; }
+
+    /// Return the size the content is laid out at.
+    Area content_size() const;
+
+    /// Return the largest offset that still fills the viewport with content.
+    Point max_offset() const;
+
+    /// Move and resize the content to fill the virtual space.
+    void update_geometry();
+
+    /// Remove the tiles painted by \p descendant from the canvas, and forget it.
+    void erase(Widget& descendant);
+
+    /// Replace each of \p tiles on the canvas with \p underneath, unless
+    /// painted over since.
+    void erase_tiles(const detail::Screen_descriptor& tiles,
+                     const Glyph& underneath);
+
+    /// Fill the cells \p descendant owns on the canvas with its wallpaper.
+    /** Cells covered by its enabled children are left to the children. Each
+     *  filled cell is added to \p painted. */
+    void paint_wallpaper(const Widget& descendant,
+                         detail::Screen_descriptor& painted);
+};
+
+}  // namespace cppurses
+#endif  // CPPURSES_WIDGET_WIDGETS_SCROLL_AREA_HPP
@@ -39,6 +39,10 @@ class Text_display : public Widget {
     /** Applys insert_brush to each Glyph inserted. */
     void append(Glyph_string text);
 
+    /// Allocate room for \p length Glyphs of contents.
+    /** Keeps appending text in many pieces from copying the contents. */
+    void reserve(std::size_t length) { contents_.reserve(length); }
+
     /// Remove Glyphs from contents starting at \p index, for \p length Glyphs.
     void erase(std::size_t index, std::size_t length = Glyph_string::npos);
 
@@ -158,7 +162,8 @@ class Text_display : public Widget {
 
     /// Recalculate the text layout via display_state_.
     /** This updates display_state_, depends on the Widget's dimensions, if word
-     *  wrap is enabled, and the contents.*/
+     *  wrap is enabled, and the contents. Lines before \p from_line are kept
+     *  as they are, for when only text after their end has changed.*/
     void update_display(std::size_t from_line = 0);
 
    private:
@@ -176,6 +181,9 @@ class Text_display : public Widget {
 
     bool word_wrap_enabled_{true};
     Alignment alignment_{Alignment::Left};
+
+    /// Return the first line an edit at \p index can change the layout of.
+    std::size_t relayout_line(std::size_t index) const;
 };
 
 }  // namespace cppurses
@@ -5,6 +5,7 @@
 #include <cppurses/painter/glyph_string.hpp>
 #include <cppurses/system/events/key.hpp>
 #include <cppurses/system/events/mouse.hpp>
+#include <cppurses/system/undo_stack.hpp>
 #include <cppurses/widget/widgets/detail/textbox_base.hpp>
 
 namespace cppurses {
@@ -46,6 +47,17 @@ class Textbox : public detail::Textbox_base {
     /// Disable the Textbox from taking keyboard input.
     void disable_input() { takes_input_ = false; }
 
+    /// Revert the last edit made from the keyboard, no-op if there is none.
+    /** Consecutive typing, or erasing, on one line is a single edit. Ctrl-z
+     *  also calls this. Setting the contents directly clears the history. */
+    void undo();
+
+    /// Reapply the last undone edit, no-op if there is none. Also on Ctrl-y.
+    void redo();
+
+    /// Limit the memory used by the undo history to about \p bytes.
+    void set_undo_budget(std::size_t bytes) { history_.set_byte_budget(bytes); }
+
    protected:
     /// Either input a Glyph from the Key, or move the cursor on arrow presses.
     bool key_press_event(const Key::State& keyboard) override;
@@ -54,10 +66,39 @@ class Textbox : public detail::Textbox_base {
     bool mouse_press_event(const Mouse::State& mouse) override;
 
    private:
+    /// Glyphs removed from, then inserted at, a single index of the contents.
+    struct Text_edit {
+        std::size_t index;
+        Glyph_string removed;
+        Glyph_string inserted;
+
+        std::size_t bytes() const;
+
+        /// Absorb \p next if it continues typing or erasing from this edit.
+        bool merge(const Text_edit& next);
+    };
+
     bool scroll_wheel_{true};
     bool takes_input_{true};
     std::size_t scroll_speed_up_{1};
     std::size_t scroll_speed_down_{1};
+    Undo_stack<Text_edit> history_;
+    bool applying_edit_{false};
+
+    /// Replace \p length Glyphs at \p index with \p text.
+    /** Returns the Glyphs removed. The history is left as is. */
+    Glyph_string replace(std::size_t index,
+                         std::size_t length,
+                         const Glyph_string& text);
+
+    /// Replace Glyphs as replace() does, \p text is put back as it was.
+    /** For undo and redo, the insert_brush is not applied to \p text. */
+    void restore(std::size_t index,
+                 std::size_t length,
+                 const Glyph_string& text);
+
+    /// Replace Glyphs as replace() does and record the edit in the history.
+    void edit(std::size_t index, std::size_t length, const Glyph_string& text);
 };
 
 }  // namespace cppurses
@@ -0,0 +1,167 @@
+#ifndef CPPURSES_WIDGET_WIDGETS_VIRTUAL_MENU_HPP
+#define CPPURSES_WIDGET_WIDGETS_VIRTUAL_MENU_HPP
+#include <atomic>
+#include <cstddef>
+#include <future>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <vector>
+
+#include <signals/signal.hpp>
+#include <signals/slot.hpp>
+
+#include <cppurses/painter/attribute.hpp>
+#include <cppurses/painter/glyph_string.hpp>
+#include <cppurses/system/events/key.hpp>
+#include <cppurses/system/events/mouse.hpp>
+#include <cppurses/widget/widget.hpp>
+
+namespace cppurses {
+
+/// Menu that holds its items as plain data and only paints the visible rows.
+/** Unlike Menu, no child Widget is created per item, so very long lists are
+ *  cheap to hold and to scroll through. Typing filters the items by case
+ *  insensitive substring, Backspace removes the last filter character and
+ *  Escape clears the filter. Item indices given to and sent from this class
+ *  always refer to the unfiltered list. */
+class Virtual_menu : public Widget {
+   public:
+    Virtual_menu();
+
+    /// Wait for any filter running on a worker thread to stop.
+    ~Virtual_menu();
+
+    /// Append item to the end of list, displayed with \p label.
+    void append_item(Glyph_string label);
+
+    /// Insert item at \p index, displayed with \p label.
+    /** No-op if \p index is larger than this->size(). */
+    void insert_item(Glyph_string label, std::size_t index);
+
+    /// Remove item at \p index, no-op if \p index is invalid.
+    void remove_item(std::size_t index);
+
+    /// Remove all items, the filter is kept.
+    void clear();
+
+    /// Return the number of items in the Menu, including filtered out items.
+    std::size_t size() const { return labels_.size(); }
+
+    /// Return the label of the item at \p index.
+    const Glyph_string& item(std::size_t index) const
+    {
+        return labels_.at(index);
+    }
+
+    /// Return the number of items that pass the current filter.
+    std::size_t match_count() const { return matches_.size(); }
+
+    /// Select the item at \p index, does not send Signal.
+    /** No-op if the item at \p index does not pass the current filter. */
+    void select_item(std::size_t index);
+
+    /// Return the index of the currently selected item.
+    /** Returns this->size() if no item passes the filter. */
+    std::size_t selected_item() const;
+
+    /// Move the selection up by \p n displayed items, clamps to the first.
+    void select_up(std::size_t n = 1);
+
+    /// Move the selection down by \p n displayed items, clamps to the last.
+    void select_down(std::size_t n = 1);
+
+    /// Set the Attribute applied to the selected item.
+    void set_selected_attribute(const Attribute& attr);
+
+    /// Only display items with a label containing \p pattern.
+    /** Case insensitive. If the filter only grew since the last result, only
+     *  the previous matches are searched again. */
+    void set_filter(std::wstring pattern);
+
+    /// Return the current filter pattern.
+    const std::wstring& filter() const { return filter_; }
+
+    /// Return true if a filter is being evaluated on a worker thread.
+    bool filter_pending() const { return filter_pending_; }
+
+    /// Set the number of items to search at which filtering moves off thread.
+    /** Default is 10,000. Smaller searches are done immediately. */
+    void set_async_threshold(std::size_t count) { async_threshold_ = count; }
+
+    /// Emitted on Enter Key or click, sends the index of the selected item.
+    sig::Signal<void(std::size_t)> selected;
+
+    /// Emitted when the filter pattern changes, sends the new pattern.
+    sig::Signal<void(const std::wstring&)> filter_changed;
+
+   protected:
+    bool paint_event() override;
+    bool key_press_event(const Key::State& keyboard) override;
+    bool mouse_press_event(const Mouse::State& mouse) override;
+    bool resize_event(Area new_size, Area old_size) override;
+    bool enable_event() override;
+
+   private:
+    using Keys_t = std::vector<std::wstring>;
+
+    /// Result of a filter run on a worker thread.
+    struct Filter_result {
+        std::size_t generation{0};
+        std::wstring pattern;
+        std::size_t key_count{0};
+        std::vector<std::size_t> matches;
+        bool ready{false};
+    };
+
+    std::vector<Glyph_string> labels_;
+    std::shared_ptr<Keys_t> keys_{std::make_shared<Keys_t>()};
+
+    // Indices into labels_ that pass matches_pattern_, in ascending order.
+    std::vector<std::size_t> matches_;
+    std::wstring matches_pattern_;
+    std::wstring filter_;
+
+    std::size_t selected_{0};  // Index into matches_.
+    std::size_t top_{0};       // Index into matches_ of the first row shown.
+    Attribute selected_attr_{Attribute::Inverse};
+    std::size_t async_threshold_{10'000};
+
+    std::atomic<std::size_t> generation_{0};
+    bool filter_pending_{false};
+    std::mutex result_mtx_;
+    Filter_result result_;
+    std::future<void> worker_;
+
+    /// Return the number of rows available to display items.
+    std::size_t visible_rows() const;
+
+    /// Move top_ so that the selected item is on screen.
+    void scroll_to_selected();
+
+    /// Return a writable key list, copied if a worker thread still reads it.
+    Keys_t& writable_keys();
+
+    /// Filter items with filter_, from previous matches when possible.
+    void apply_filter();
+
+    /// Install the result of a worker thread filter, if it is still current.
+    void collect_filter_result();
+
+    /// Install \p matches as the new filter result for \p pattern.
+    void set_matches(std::vector<std::size_t> matches, std::wstring pattern);
+
+    /// Send the Signal with the currently selected item, if any.
+    void send_selected_signal();
+};
+
+namespace slot {
+
+sig::Slot<void()> select_up(Virtual_menu& m, std::size_t n);
+sig::Slot<void()> select_down(Virtual_menu& m, std::size_t n);
+sig::Slot<void(std::size_t)> select_item(Virtual_menu& m);
+sig::Slot<void(std::wstring)> set_filter(Virtual_menu& m);
+
+}  // namespace slot
+}  // namespace cppurses
+#endif  // CPPURSES_WIDGET_WIDGETS_VIRTUAL_MENU_HPP
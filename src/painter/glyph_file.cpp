@@ -0,0 +1,274 @@
+#include <cppurses/painter/glyph_file.hpp>
+
+#include <algorithm>
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <limits>
+#include <ostream>
+#include <stdexcept>
+#include <string>
+#include <vector>
+
+#include <optional/optional.hpp>
+
+#include <cppurses/painter/attribute.hpp>
+#include <cppurses/painter/brush.hpp>
+#include <cppurses/painter/color.hpp>
+#include <cppurses/painter/glyph.hpp>
+#include <cppurses/painter/glyph_matrix.hpp>
+
+namespace {
+using namespace cppurses;
+
+const char signature[4] = {'C', 'P', 'G', 'F'};
+const std::size_t header_size{24};
+const std::size_t palette_entry_size{4};
+const std::size_t run_size{12};
+
+const std::uint8_t has_background{1};
+const std::uint8_t has_foreground{2};
+
+std::uint16_t read_u16(const char* data) {
+    const auto* bytes = reinterpret_cast<const unsigned char*>(data);
+    return bytes[0] | bytes[1] << 8;
+}
+
+std::uint32_t read_u32(const char* data) {
+    const auto* bytes = reinterpret_cast<const unsigned char*>(data);
+    return static_cast<std::uint32_t>(bytes[0]) | bytes[1] << 8 |
+           bytes[2] << 16 | static_cast<std::uint32_t>(bytes[3]) << 24;
+}
+
+void store_u16(char* data, std::uint16_t value) {
+    data[0] = static_cast<char>(value & 0xFF);
+    data[1] = static_cast<char>(value >> 8);
+}
+
+void store_u32(char* data, std::uint32_t value) {
+    store_u16(data, value & 0xFFFF);
+    store_u16(data + 2, value >> 16);
+}
+
+/// Return \p brush as a palette entry, in file byte order.
+std::uint32_t encode(const Brush& brush) {
+    std::uint32_t attributes{0};
+    for (Attribute a : Attribute_list) {
+        if (brush.has_attribute(a)) {
+            attributes |= 1 << static_cast<int>(a);
+        }
+    }
+    std::uint32_t flags{0};
+    std::uint32_t colors{0};
+    if (brush.background_color()) {
+        flags |= has_background;
+        colors |= static_cast<std::uint8_t>(*brush.background_color()) << 16;
+    }
+    if (brush.foreground_color()) {
+        flags |= has_foreground;
+        colors |= static_cast<std::uint32_t>(
+                      static_cast<std::uint8_t>(*brush.foreground_color()))
+                  << 24;
+    }
+    return attributes | flags << 8 | colors;
+}
+
+/// Return the Brush stored as palette entry \p entry.
+Brush decode(std::uint32_t entry) {
+    Brush brush;
+    for (Attribute a : Attribute_list) {
+        if ((entry & (1 << static_cast<int>(a))) != 0) {
+            brush.add_attributes(a);
+        }
+    }
+    const std::uint32_t flags{(entry >> 8) & 0xFF};
+    if ((flags & has_background) != 0) {
+        brush.set_background(static_cast<Color>((entry >> 16) & 0xFF));
+    }
+    if ((flags & has_foreground) != 0) {
+        brush.set_foreground(static_cast<Color>(entry >> 24));
+    }
+    return brush;
+}
+
+[[noreturn]] void malformed(const char* reason) {
+    throw std::runtime_error{std::string{"Glyph_file: "} + reason};
+}
+
+}  // namespace
+
+namespace cppurses {
+
+constexpr std::uint16_t Glyph_file::version;
+constexpr std::uint16_t Glyph_file::empty;
+constexpr std::uint64_t Glyph_file::max_cells;
+
+bool Glyph_file::has_signature(const char* data, std::size_t size) {
+    return size >= sizeof(signature) &&
+           std::memcmp(data, signature, sizeof(signature)) == 0;
+}
+
+Glyph_file::Glyph_file(const char* data, std::size_t size) {
+    if (!has_signature(data, size) || size < header_size) {
+        malformed("not a glyph file.");
+    }
+    if (read_u16(data + 4) != version) {
+        malformed("unsupported version.");
+    }
+    width_ = read_u32(data + 8);
+    height_ = read_u32(data + 12);
+    // Checked on each side as well, the product of 0 and any width is 0.
+    if (width_ > max_cells || height_ > max_cells ||
+        std::uint64_t{width_} * height_ > max_cells) {
+        malformed("area too large.");
+    }
+    const std::uint64_t palette_size{read_u32(data + 16)};
+    run_count_ = read_u32(data + 20);
+    const std::uint64_t expected_size{header_size +
+                                      palette_size * palette_entry_size +
+                                      std::uint64_t{run_count_} * run_size};
+    if (size < expected_size) {
+        malformed("truncated data.");
+    }
+    const char* palette = data + header_size;
+    palette_.reserve(palette_size);
+    for (std::size_t i{0}; i < palette_size; ++i) {
+        palette_.push_back(decode(read_u32(palette + i * palette_entry_size)));
+    }
+    runs_ = palette + palette_size * palette_entry_size;
+    std::uint64_t cells{0};
+    for (std::size_t i{0}; i < run_count_; ++i) {
+        const Run r{this->run(i)};
+        if (r.style != empty && r.style >= palette_.size()) {
+            malformed("palette index out of range.");
+        }
+        cells += r.length;
+    }
+    if (cells != std::uint64_t{width_} * height_) {
+        malformed("runs do not cover the area.");
+    }
+}
+
+Glyph_matrix Glyph_file::to_matrix() const {
+    Glyph_matrix matrix{width_, height_};
+    this->for_each_run([&matrix](std::size_t x, std::size_t y,
+                                 std::size_t length, const Glyph& glyph) {
+        std::fill_n(matrix.row(y) + x, length, glyph);
+    });
+    return matrix;
+}
+
+Glyph_file::Run Glyph_file::run(std::size_t index) const {
+    const char* record = runs_ + index * run_size;
+    return {static_cast<wchar_t>(read_u32(record)), read_u16(record + 4),
+            read_u32(record + 8)};
+}
+
+Glyph_file_writer::Glyph_file_writer(std::size_t width, std::size_t height)
+    : width_{width}, height_{height} {}
+
+void Glyph_file_writer::append(const Glyph& glyph, std::size_t count) {
+    if (palette_.empty() || !(glyph.brush == last_brush_)) {
+        const std::uint32_t entry{encode(glyph.brush)};
+        auto iter = palette_index_.find(entry);
+        if (iter == std::end(palette_index_)) {
+            if (palette_.size() == Glyph_file::empty) {
+                throw std::length_error{"Glyph_file_writer: too many Brushes."};
+            }
+            const auto style = static_cast<std::uint16_t>(palette_.size());
+            iter = palette_index_.emplace(entry, style).first;
+            palette_.push_back(entry);
+        }
+        last_brush_ = glyph.brush;
+        last_style_ = iter->second;
+    }
+    this->add_run(static_cast<std::uint32_t>(glyph.symbol), last_style_, count);
+}
+
+void Glyph_file_writer::skip(std::size_t count) {
+    this->add_run(L' ', Glyph_file::empty, count);
+}
+
+void Glyph_file_writer::write(std::ostream& os) const {
+    const std::size_t cells{width_ * height_};
+    const bool pad = cell_count_ < cells;
+    char header[header_size];
+    std::memcpy(header, signature, sizeof(signature));
+    store_u16(header + 4, Glyph_file::version);
+    store_u16(header + 6, 0);
+    store_u32(header + 8, width_);
+    store_u32(header + 12, height_);
+    store_u32(header + 16, palette_.size());
+    store_u32(header + 20, runs_.size() + (pad ? 1 : 0));
+    os.write(header, header_size);
+
+    std::vector<char> buffer(palette_.size() * palette_entry_size);
+    for (std::size_t i{0}; i < palette_.size(); ++i) {
+        store_u32(buffer.data() + i * palette_entry_size, palette_[i]);
+    }
+    os.write(buffer.data(), buffer.size());
+
+    // Runs are encoded into the buffer and written a block at a time.
+    const std::size_t runs_per_block{4096};
+    buffer.resize(runs_per_block * run_size);
+    std::size_t buffered{0};
+    const auto add = [&os, &buffer, &buffered](const Run& r) {
+        char* record = buffer.data() + buffered * run_size;
+        store_u32(record, r.symbol);
+        store_u16(record + 4, r.style);
+        store_u16(record + 6, 0);
+        store_u32(record + 8, r.length);
+        if (++buffered == runs_per_block) {
+            os.write(buffer.data(), buffered * run_size);
+            buffered = 0;
+        }
+    };
+    for (const Run& r : runs_) {
+        add(r);
+    }
+    if (pad) {
+        add({L' ', Glyph_file::empty,
+             static_cast<std::uint32_t>(cells - cell_count_)});
+    }
+    os.write(buffer.data(), buffered * run_size);
+}
+
+void Glyph_file_writer::add_run(std::uint32_t symbol,
+                                std::uint16_t style,
+                                std::size_t count) {
+    const std::uint32_t max_length{std::numeric_limits<std::uint32_t>::max()};
+    count = std::min(count, width_ * height_ - cell_count_);
+    if (count == 0) {
+        return;
+    }
+    cell_count_ += count;
+    if (!runs_.empty()) {
+        Run& last = runs_.back();
+        const bool same = last.style == style &&
+                          (style == Glyph_file::empty || last.symbol == symbol);
+        if (same) {
+            const std::size_t added{std::min<std::size_t>(
+                count, max_length - last.length)};
+            last.length += added;
+            count -= added;
+        }
+    }
+    while (count != 0) {
+        const std::size_t length{std::min<std::size_t>(count, max_length)};
+        runs_.push_back({symbol, style, static_cast<std::uint32_t>(length)});
+        count -= length;
+    }
+}
+
+void write_glyph_file(std::ostream& os, const Glyph_matrix& matrix) {
+    Glyph_file_writer writer{matrix.width(), matrix.height()};
+    for (std::size_t y{0}; y < matrix.height(); ++y) {
+        const Glyph* row = matrix.row(y);
+        for (std::size_t x{0}; x < matrix.width(); ++x) {
+            writer.append(row[x]);
+        }
+    }
+    writer.write(os);
+}
+
+}  // namespace cppurses
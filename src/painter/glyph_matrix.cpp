@@ -1,18 +1,28 @@
 #include <cppurses/painter/glyph_matrix.hpp>
 
+#include <algorithm>
 #include <cstddef>
+#include <utility>
+#include <vector>
 
 #include <cppurses/painter/glyph.hpp>
 
 namespace cppurses {
 
 void Glyph_matrix::resize(std::size_t width, std::size_t height) {
-    matrix_.resize(height);
-    matrix_.shrink_to_fit();
-    for (auto& row : matrix_) {
-        row.resize(width, Glyph{L' '});
-        row.shrink_to_fit();
+    if (width == width_ && height == height_) {
+        return;
     }
+    std::vector<Glyph> resized(width * height, Glyph{L' '});
+    const auto copy_width = std::min(width, width_);
+    const auto copy_height = std::min(height, height_);
+    for (std::size_t y{0}; y < copy_height; ++y) {
+        const Glyph* source = this->row(y);
+        std::copy(source, source + copy_width, resized.data() + y * width);
+    }
+    glyphs_ = std::move(resized);
+    width_ = width;
+    height_ = height;
 }
 
 }  // namespace cppurses
@@ -0,0 +1,220 @@
+#include <cppurses/painter/detail/layers.hpp>
+
+#include <algorithm>
+#include <cstddef>
+#include <iterator>
+
+#include <cppurses/painter/glyph.hpp>
+#include <cppurses/system/system.hpp>
+#include <cppurses/terminal/output.hpp>
+#include <cppurses/widget/widget.hpp>
+
+namespace cppurses {
+namespace detail {
+
+void Layers::add(Widget& overlay)
+{
+    if (this->is_overlay(overlay))
+        return;
+    overlays_.push_back(Overlay{&overlay, Rect{Point{0, 0}, Area{0, 0}},
+                                Glyph_matrix{}, sig::Connection{}});
+    overlays_.back().on_destroyed = overlay.destroyed.connect(
+        [this](Widget& destroyed) { this->remove(destroyed); });
+}
+
+void Layers::remove(const Widget& overlay)
+{
+    auto at = std::find_if(
+        std::begin(overlays_), std::end(overlays_),
+        [&overlay](const Overlay& o) { return o.widget == &overlay; });
+    if (at == std::end(overlays_))
+        return;
+    uncovered_.push_back(at->rect);
+    at->on_destroyed.disconnect();
+    overlays_.erase(at);
+}
+
+bool Layers::is_overlay(const Widget& widg) const
+{
+    return std::any_of(
+        std::begin(overlays_), std::end(overlays_),
+        [&widg](const Overlay& o) { return o.widget == &widg; });
+}
+
+Widget* Layers::overlay_at(std::size_t x, std::size_t y) const
+{
+    for (auto iter = overlays_.rbegin(); iter != overlays_.rend(); ++iter) {
+        if (iter->widget->enabled() && iter->rect.contains(x, y))
+            return iter->widget;
+    }
+    return nullptr;
+}
+
+std::size_t Layers::layer_of(const Widget& widg) const
+{
+    if (overlays_.empty())
+        return 0;
+    const Widget* root = &widg;
+    while (root->parent() != nullptr)
+        root = root->parent();
+    for (std::size_t i{0}; i < overlays_.size(); ++i) {
+        if (overlays_[i].widget == root)
+            return i + 1;
+    }
+    return 0;
+}
+
+bool Layers::composite()
+{
+    for (auto& overlay : overlays_) {
+        const auto& widg = *overlay.widget;
+        Rect current{Point{widg.x(), widg.y()},
+                     Area{widg.outer_width(), widg.outer_height()}};
+        if (!widg.enabled())
+            current.size = Area{0, 0};
+        const auto& previous = overlay.rect;
+        if (current.position == previous.position &&
+            current.size.width == previous.size.width &&
+            current.size.height == previous.size.height) {
+            continue;
+        }
+        // The cache is local to the overlay, so it moves along with it, the
+        // terminal has to be told. Cells repainted with the same tile are then
+        // skipped by Screen, see Layers::holds().
+        if (current.position != previous.position)
+            uncovered_.push_back(current);
+        uncovered_.push_back(previous);
+        overlay.rect = current;
+        overlay.cache.resize(current.size.width, current.size.height);
+    }
+    if (uncovered_.empty())
+        return false;
+    for (const auto& rect : uncovered_) {
+        const auto x_end = rect.position.x + rect.size.width;
+        const auto y_end = rect.position.y + rect.size.height;
+        for (auto y = rect.position.y; y < y_end; ++y) {
+            for (auto x = rect.position.x; x < x_end; ++x) {
+                this->restore(x, y);
+            }
+        }
+    }
+    uncovered_.clear();
+    return true;
+}
+
+void Layers::put(std::size_t layer,
+                 std::size_t x,
+                 std::size_t y,
+                 const Glyph& tile)
+{
+    if (layer == 0) {
+        if (x >= base_.width() || y >= base_.height()) {
+            base_.resize(std::max(x + 1, System::terminal.width()),
+                         std::max(y + 1, System::terminal.height()));
+        }
+        base_(x, y) = tile;
+    }
+    else {
+        auto& overlay = overlays_[layer - 1];
+        if (!overlay.rect.contains(x, y))
+            return;
+        overlay.cache(x - overlay.rect.position.x,
+                      y - overlay.rect.position.y) = tile;
+    }
+    if (!this->is_covered(layer, x, y))
+        output::put(x, y, tile);
+}
+
+bool Layers::holds(std::size_t layer,
+                   std::size_t x,
+                   std::size_t y,
+                   const Glyph& tile) const
+{
+    if (layer == 0)
+        return x < base_.width() && y < base_.height() && base_(x, y) == tile;
+    const auto& overlay = overlays_[layer - 1];
+    return overlay.rect.contains(x, y) &&
+           overlay.cache(x - overlay.rect.position.x,
+                         y - overlay.rect.position.y) == tile;
+}
+
+bool Layers::shift_rows(std::size_t layer,
+                        std::size_t x,
+                        std::size_t y,
+                        Area size,
+                        int rows)
+{
+    const Rect rect{Point{x, y}, size};
+    for (auto i = layer; i < overlays_.size(); ++i) {
+        if (overlays_[i].rect.intersects(rect))
+            return false;
+    }
+    auto& cache  = layer == 0 ? base_ : overlays_[layer - 1].cache;
+    const auto origin =
+        layer == 0 ? Point{0, 0} : overlays_[layer - 1].rect.position;
+    if (x < origin.x || y < origin.y ||
+        x + size.width > origin.x + cache.width() ||
+        y + size.height > origin.y + cache.height()) {
+        return false;
+    }
+    if (!output::shift_rows(x, y, size.width, size.height, rows))
+        return false;
+    shift_cache(cache, origin, rect, rows);
+    return true;
+}
+
+void Layers::shift_cache(Glyph_matrix& cache,
+                         Point origin,
+                         const Rect& rect,
+                         int rows)
+{
+    const auto x_begin = rect.position.x - origin.x;
+    const auto y_begin = rect.position.y - origin.y;
+    const auto width   = rect.size.width;
+    const auto height  = static_cast<int>(rect.size.height);
+    const auto shift_row = [&](int to, int from) {
+        auto* dest = cache.row(y_begin + to) + x_begin;
+        if (from < 0 || from >= height) {
+            std::fill(dest, dest + width, Glyph{L' '});
+            return;
+        }
+        const auto* source = cache.row(y_begin + from) + x_begin;
+        std::copy(source, source + width, dest);
+    };
+    // Copy in the direction that never reads a row already overwritten.
+    if (rows > 0) {
+        for (int y{0}; y < height; ++y)
+            shift_row(y, y + rows);
+    }
+    else {
+        for (int y{height - 1}; y >= 0; --y)
+            shift_row(y, y + rows);
+    }
+}
+
+bool Layers::is_covered(std::size_t layer, std::size_t x, std::size_t y) const
+{
+    // Overlay i is layer i + 1, so overlays from index layer are above it.
+    for (auto i = layer; i < overlays_.size(); ++i) {
+        if (overlays_[i].rect.contains(x, y))
+            return true;
+    }
+    return false;
+}
+
+void Layers::restore(std::size_t x, std::size_t y) const
+{
+    for (auto iter = overlays_.rbegin(); iter != overlays_.rend(); ++iter) {
+        const auto& rect = iter->rect;
+        if (rect.contains(x, y)) {
+            output::put(x, y,
+                        iter->cache(x - rect.position.x, y - rect.position.y));
+            return;
+        }
+    }
+    if (x < base_.width() && y < base_.height())
+        output::put(x, y, base_(x, y));
+}
+
+}  // namespace detail
+}  // namespace cppurses
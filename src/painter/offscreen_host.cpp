@@ -0,0 +1,63 @@
+#include <cppurses/painter/detail/offscreen_host.hpp>
+
+#include <unordered_map>
+
+#include <cppurses/widget/widget.hpp>
+
+namespace cppurses {
+namespace detail {
+
+Offscreen_host::Offscreen_host(Widget& self) : self_{self}
+{
+    registry()[&self_] = this;
+}
+
+Offscreen_host::~Offscreen_host() { registry().erase(&self_); }
+
+Offscreen_host* Offscreen_host::find(const Widget& widg)
+{
+    const auto& hosts = registry();
+    if (hosts.empty())
+        return nullptr;
+    for (const Widget* w = widg.parent(); w != nullptr; w = w->parent()) {
+        const auto at = hosts.find(w);
+        if (at != hosts.end())
+            return at->second;
+    }
+    return nullptr;
+}
+
+Offscreen_host* Offscreen_host::as_host(const Widget& widg)
+{
+    const auto& hosts = registry();
+    const auto at     = hosts.find(&widg);
+    return at == hosts.end() ? nullptr : at->second;
+}
+
+bool Offscreen_host::to_screen(const Widget& widg, Point& position)
+{
+    for (auto* host = find(widg); host != nullptr;
+         host       = find(host->widget())) {
+        const auto offset = host->scroll_offset();
+        const auto& area  = host->widget();
+        if (position.x < offset.x || position.y < offset.y)
+            return false;
+        position.x -= offset.x;
+        position.y -= offset.y;
+        if (position.x < area.inner_x() || position.y < area.inner_y() ||
+            position.x >= area.inner_x() + area.width() ||
+            position.y >= area.inner_y() + area.height()) {
+            return false;
+        }
+    }
+    return true;
+}
+
+std::unordered_map<const Widget*, Offscreen_host*>& Offscreen_host::registry()
+{
+    static std::unordered_map<const Widget*, Offscreen_host*> hosts;
+    return hosts;
+}
+
+}  // namespace detail
+}  // namespace cppurses
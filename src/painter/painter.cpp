@@ -1,12 +1,15 @@
 #include <cppurses/painter/painter.hpp>
 
+#include <algorithm>
 #include <cstddef>
 #include <string>
 #include <unordered_map>
 
 #include <cppurses/painter/detail/is_paintable.hpp>
 #include <cppurses/painter/detail/screen_descriptor.hpp>
+#include <cppurses/painter/detail/screen_state.hpp>
 #include <cppurses/painter/detail/staged_changes.hpp>
+#include <cppurses/painter/glyph_matrix.hpp>
 #include <cppurses/painter/glyph_string.hpp>
 #include <cppurses/system/event_loop.hpp>
 #include <cppurses/system/system.hpp>
@@ -22,6 +25,24 @@ bool border_is_paintable(const cppurses::Widget& widg)
            widg.outer_height() != 0;
 }
 
+/// Return true if every Segment of \p a looks and is enabled the same as \p b.
+bool same_segments(const cppurses::Border::Segments& a,
+                   const cppurses::Border::Segments& b)
+{
+    using Segment      = cppurses::Border::Segment;
+    const auto is_same = [](const Segment& x, const Segment& y) {
+        return x.enabled() == y.enabled() &&
+               static_cast<const cppurses::Glyph&>(x) ==
+                   static_cast<const cppurses::Glyph&>(y);
+    };
+    return is_same(a.north, b.north) && is_same(a.south, b.south) &&
+           is_same(a.east, b.east) && is_same(a.west, b.west) &&
+           is_same(a.north_west, b.north_west) &&
+           is_same(a.north_east, b.north_east) &&
+           is_same(a.south_west, b.south_west) &&
+           is_same(a.south_east, b.south_east);
+}
+
 }  // namespace
 
 namespace cppurses {
@@ -51,11 +72,72 @@ void Painter::put(const Glyph_string& text, std::size_t x, std::size_t y)
     }
 }
 
+void Painter::blit(const Glyph_matrix& matrix, Point offset, Point position)
+{
+    if (offset.x >= matrix.width() || offset.y >= matrix.height())
+        return;
+    auto area = this->region(position, Area{matrix.width() - offset.x,
+                                            matrix.height() - offset.y});
+    if (area.empty())
+        return;
+    staged_changes_.reserve(staged_changes_.size() +
+                            area.width() * area.height());
+    for (std::size_t y{0}; y < area.height(); ++y) {
+        const Glyph* const span = matrix.row(offset.y + y) + offset.x;
+        for (std::size_t x{0}; x < area.width(); ++x) {
+            area.put(span[x], x, y);
+        }
+    }
+}
+
 void Painter::border()
 {
-    using Offset = detail::Border_offset;
     if (!border_is_paintable(widget_))
         return;
+    // Borders rarely change, they are only rendered again if an input has.
+    auto& cache           = widget_.border.cache_;
+    const auto& segments  = widget_.border.segments;
+    const auto& wallpaper = widget_.generate_wallpaper();
+    if (!cache.valid || cache.width != widget_.outer_width() ||
+        cache.height != widget_.outer_height() ||
+        !same_segments(cache.segments, segments) ||
+        !(cache.wallpaper == wallpaper)) {
+        cache.spans.clear();
+        this->render_border(cache.spans);
+        cache.valid     = true;
+        cache.width     = widget_.outer_width();
+        cache.height    = widget_.outer_height();
+        cache.segments  = segments;
+        cache.wallpaper = wallpaper;
+    }
+    const auto x = widget_.x();
+    const auto y = widget_.y();
+    for (const auto& span : cache.spans) {
+        const auto x_begin = x + span.start.x;
+        const auto y_begin = y + span.start.y;
+        for (std::size_t i{0}; i < span.length; ++i) {
+            if (span.vertical)
+                this->put_global(span.glyph, x_begin, y_begin + i);
+            else
+                this->put_global(span.glyph, x_begin + i, y_begin);
+        }
+    }
+}
+
+void Painter::render_border(std::vector<Border::Span>& spans) const
+{
+    using Offset = detail::Border_offset;
+    // Records the line from a to b, inclusive, relative to the Widget.
+    const Point origin{widget_.x(), widget_.y()};
+    const auto add_span = [&spans, origin](const Glyph& tile, Point a,
+                                           Point b) {
+        if (b.x < a.x || b.y < a.y)
+            return;
+        const auto vertical = a.x == b.x && a.y != b.y;
+        const auto length   = vertical ? b.y - a.y + 1 : b.x - a.x + 1;
+        spans.push_back(Border::Span{
+            Point{a.x - origin.x, a.y - origin.y}, length, vertical, tile});
+    };
     // Disqualified borders
     auto const west_dq  = Offset::west_disqualified(widget_);
     auto const east_dq  = Offset::east_disqualified(widget_);
@@ -92,21 +174,21 @@ void Painter::border()
     auto const& b = widget_.border.segments;
 
     if (b.north.enabled() && !north_dq)
-        this->line_global(b.north, north_left, north_right);
+        add_span(b.north, north_left, north_right);
     if (b.south.enabled() && !south_dq)
-        this->line_global(b.south, south_left, south_right);
+        add_span(b.south, south_left, south_right);
     if (b.west.enabled() && !west_dq)
-        this->line_global(b.west, west_top, west_bottom);
+        add_span(b.west, west_top, west_bottom);
     if (b.east.enabled() && !east_dq)
-        this->line_global(b.east, east_top, east_bottom);
+        add_span(b.east, east_top, east_bottom);
     if (b.north_west.enabled() && !north_dq && !west_dq)
-        this->put_global(b.north_west, north_west);
+        add_span(b.north_west, north_west, north_west);
     if (b.north_east.enabled() && !north_dq && !east_dq)
-        this->put_global(b.north_east, north_east);
+        add_span(b.north_east, north_east, north_east);
     if (b.south_west.enabled() && !south_dq && !west_dq)
-        this->put_global(b.south_west, south_west);
+        add_span(b.south_west, south_west, south_west);
     if (b.south_east.enabled() && !south_dq && !east_dq)
-        this->put_global(b.south_east, south_east);
+        add_span(b.south_east, south_east, south_east);
 
     // Stop out of bounds drawing for special cases.
     if (north_dq && south_dq && inner_area_.height == 1)
@@ -118,62 +200,62 @@ void Painter::border()
     // North-West
     if (!b.north_west.enabled()) {
         if (b.north.enabled() && !b.west.enabled())
-            put_global(b.north, north_west);
+            add_span(b.north, north_west, north_west);
         else if (b.west.enabled() && !b.north.enabled())
-            put_global(b.west, north_west);
+            add_span(b.west, north_west, north_west);
     }
     // North-East
     if (!b.north_east.enabled()) {
         if (b.north.enabled() && !b.east.enabled())
-            put_global(b.north, north_east);
+            add_span(b.north, north_east, north_east);
         else if (b.east.enabled() && !b.north.enabled())
-            put_global(b.east, north_east);
+            add_span(b.east, north_east, north_east);
     }
     // South-West
     if (!b.south_west.enabled()) {
         if (b.south.enabled() && !b.west.enabled())
-            put_global(b.south, south_west);
+            add_span(b.south, south_west, south_west);
         else if (b.west.enabled() && !b.south.enabled())
-            put_global(b.west, south_west);
+            add_span(b.west, south_west, south_west);
     }
     // South-East
     if (!b.south_east.enabled()) {
         if (b.south.enabled() && !b.east.enabled())
-            put_global(b.south, south_east);
+            add_span(b.south, south_east, south_east);
         else if (b.east.enabled() && !b.south.enabled())
-            put_global(b.east, south_east);
+            add_span(b.east, south_east, south_east);
     }
 
     // Paint wallpaper over empty space that a missing border can cause
     auto const wallpaper = widget_.generate_wallpaper();
     // North Wallpaper
     if (Offset::north(widget_) == 1 && !b.north.enabled())
-        this->line_global(wallpaper, north_left, north_right);
+        add_span(wallpaper, north_left, north_right);
     // South Wallpaper
     if (Offset::south(widget_) == 1 && !b.south.enabled())
-        this->line_global(wallpaper, south_left, south_right);
+        add_span(wallpaper, south_left, south_right);
     // East Wallpaper
     if (Offset::east(widget_) == 1 && !b.east.enabled())
-        this->line_global(wallpaper, east_top, east_bottom);
+        add_span(wallpaper, east_top, east_bottom);
     // West Wallpaper
     if (Offset::west(widget_) == 1 && !b.west.enabled())
-        this->line_global(wallpaper, west_top, west_bottom);
+        add_span(wallpaper, west_top, west_bottom);
     // North-West Wallpaper
     if (Offset::north(widget_) == 1 && Offset::west(widget_) == 1 &&
         !b.north_west.enabled())
-        this->put_global(wallpaper, north_west);
+        add_span(wallpaper, north_west, north_west);
     // North-East Wallpaper
     if (Offset::north(widget_) == 1 && Offset::east(widget_) == 1 &&
         !b.north_east.enabled())
-        this->put_global(wallpaper, north_east);
+        add_span(wallpaper, north_east, north_east);
     // South-West Wallpaper
     if (Offset::south(widget_) == 1 && Offset::west(widget_) == 1 &&
         !b.south_west.enabled())
-        this->put_global(wallpaper, south_west);
+        add_span(wallpaper, south_west, south_west);
     // South-East Wallpaper
     if (Offset::south(widget_) == 1 && Offset::east(widget_) == 1 &&
         !b.south_east.enabled())
-        this->put_global(wallpaper, south_east);
+        add_span(wallpaper, south_east, south_east);
 }
 
 void Painter::fill(const Glyph& tile,
@@ -219,24 +301,37 @@ void Painter::line(const Glyph& tile,
     }
 }
 
-// GLOBAL COORDINATES - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
-void Painter::line_global(const Glyph& tile,
-                          std::size_t x1,
-                          std::size_t y1,
-                          std::size_t x2,
-                          std::size_t y2)
+void Painter::keep_previous()
 {
-    // Horizontal
-    if (y1 == y2) {
-        for (; x1 <= x2; ++x1) {
-            this->put_global(tile, x1, y1);
-        }
-    }  // Vertical
-    else if (x1 == x2) {
-        for (; y1 <= y2; ++y1) {
-            this->put_global(tile, x1, y1);
-        }
+    widget_.screen_state().optimize.partial = true;
+}
+
+void Painter::erase(std::size_t x, std::size_t y)
+{
+    if (x >= inner_area_.width || y >= inner_area_.height)
+        return;
+    const Point global{widget_.inner_x() + x, widget_.inner_y() + y};
+    staged_changes_.erase(global);
+    widget_.screen_state().optimize.erased.insert(global);
+}
+
+Painter::Region Painter::region()
+{
+    return this->region(Point{0, 0}, inner_area_);
+}
+
+Painter::Region Painter::region(Point position, Area size)
+{
+    auto& erased = widget_.screen_state().optimize.erased;
+    if (!is_paintable_ || position.x >= inner_area_.width ||
+        position.y >= inner_area_.height) {
+        return Region{staged_changes_, erased, Point{0, 0}, Area{0, 0}};
     }
+    const Area clipped{std::min(size.width, inner_area_.width - position.x),
+                       std::min(size.height, inner_area_.height - position.y)};
+    const Point origin{widget_.inner_x() + position.x,
+                       widget_.inner_y() + position.y};
+    return Region{staged_changes_, erased, origin, clipped};
 }
 
 }  // namespace cppurses
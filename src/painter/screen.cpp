@@ -1,7 +1,11 @@
 #include <cppurses/painter/detail/screen.hpp>
 
+#include <algorithm>
+#include <cstddef>
 #include <iterator>
 #include <mutex>
+#include <utility>
+#include <vector>
 
 #include <optional/optional.hpp>
 
@@ -10,14 +14,19 @@
 #include <cppurses/painter/color.hpp>
 #include <cppurses/painter/detail/find_empty_space.hpp>
 #include <cppurses/painter/detail/is_paintable.hpp>
+#include <cppurses/painter/detail/layers.hpp>
+#include <cppurses/painter/detail/offscreen_host.hpp>
+#include <cppurses/painter/detail/rect.hpp>
 #include <cppurses/painter/detail/screen_descriptor.hpp>
 #include <cppurses/painter/detail/screen_mask.hpp>
 #include <cppurses/painter/detail/staged_changes.hpp>
 #include <cppurses/painter/glyph.hpp>
+#include <cppurses/system/events/paint_event.hpp>
 #include <cppurses/system/focus.hpp>
 #include <cppurses/system/system.hpp>
 #include <cppurses/terminal/output.hpp>
 #include <cppurses/terminal/terminal.hpp>
+#include <cppurses/widget/area.hpp>
 #include <cppurses/widget/point.hpp>
 #include <cppurses/widget/widget.hpp>
 
@@ -30,7 +39,12 @@ bool contains(const typename Map_t::key_type& value, const Map_t& map)
     return map.count(value) > 0;
 }
 
-bool has_children(const Widget& widg) { return !(widg.children.get().empty()); }
+// Children of an Offscreen_host do not occupy any of its screen space.
+bool has_children(const Widget& widg)
+{
+    return !(widg.children.get().empty()) &&
+           detail::Offscreen_host::as_host(widg) == nullptr;
+}
 
 bool is_whitespace_equal(const Brush& a, const Brush& b)
 {
@@ -56,9 +70,13 @@ namespace detail {
 
 void Screen::flush(const Staged_changes::Map_t& changes)
 {
-    bool refresh = false;
+    bool refresh = Layers::get().composite();
+    send_to_hosts(changes);
     for (const auto& widg_description : changes) {
         auto& widget = *widg_description.first;
+        if (Offscreen_host::find(widget) != nullptr) {
+            continue;
+        }
         if (is_paintable(widget)) {
             delegate_paint(widget, widg_description.second);
             refresh = true;
@@ -75,11 +93,15 @@ void Screen::flush(const Staged_changes::Map_t& changes)
 void Screen::set_cursor_on_focus_widget()
 {
     auto* focus = Focus::focus_widget();
-    if (focus != nullptr && focus->cursor.enabled() && is_paintable(*focus)) {
+    Point position;
+    if (focus != nullptr) {
+        position = Point{focus->inner_x() + focus->cursor.x(),
+                         focus->inner_y() + focus->cursor.y()};
+    }
+    if (focus != nullptr && focus->cursor.enabled() && is_paintable(*focus) &&
+        Offscreen_host::to_screen(*focus, position)) {
         System::terminal.show_cursor();
-        const auto x_global = focus->inner_x() + focus->cursor.x();
-        const auto y_global = focus->inner_y() + focus->cursor.y();
-        output::move_cursor(x_global, y_global);
+        output::move_cursor(position.x, position.y);
     }
     else {
         System::terminal.show_cursor(false);
@@ -88,11 +110,67 @@ void Screen::set_cursor_on_focus_widget()
 
 // IMPLEMENTATION FUNCTIONS - - - - - - - - - - - - - - - - - - - - - - - - - -
 
+void Screen::send_to_hosts(const Staged_changes::Map_t& changes)
+{
+    std::vector<Widget*> descendants;
+    for (const auto& widg_description : changes) {
+        auto* widget = widg_description.first;
+        if (is_paintable(*widget) && Offscreen_host::find(*widget) != nullptr) {
+            descendants.push_back(widget);
+        }
+    }
+    // Hosts can be nested, a repainted host is handed to its own host next.
+    while (!descendants.empty()) {
+        std::vector<Offscreen_host*> hosts;
+        for (Widget* descendant : descendants) {
+            auto* host   = Offscreen_host::find(*descendant);
+            auto& state  = descendant->screen_state();
+            state.tiles  = complete(*descendant, changes.at(descendant));
+            state.optimize.reset();
+            host->receive(*descendant, state.tiles);
+            if (std::find(std::begin(hosts), std::end(hosts), host) ==
+                std::end(hosts)) {
+                hosts.push_back(host);
+            }
+        }
+        descendants.clear();
+        for (auto* host : hosts) {
+            auto& widget = host->widget();
+            System::send_event(Paint_event{widget});
+            if (contains(&widget, changes) &&
+                Offscreen_host::find(widget) != nullptr) {
+                descendants.push_back(&widget);
+            }
+        }
+    }
+}
+
+Screen_descriptor Screen::complete(const Widget& widg,
+                                   const Screen_descriptor& staged_tiles)
+{
+    const auto& state = widg.screen_state();
+    if (!state.optimize.partial)
+        return staged_tiles;
+    const Rect outer{Point{widg.x(), widg.y()},
+                     Area{widg.outer_width(), widg.outer_height()}};
+    auto tiles = staged_tiles;
+    for (const auto& point_tile : state.tiles) {
+        const auto& point = point_tile.first;
+        if (outer.contains(point.x, point.y) &&
+            !contains(point, state.optimize.erased)) {
+            tiles.insert(point_tile);
+        }
+    }
+    return tiles;
+}
+
 void Screen::paint_empty_tiles(const Widget& widg)
 {
     if (!has_children(widg)) {
         return;
     }
+    auto& layers           = Layers::get();
+    const auto layer       = layers.layer_of(widg);
     const auto wallpaper   = widg.generate_wallpaper();
     const auto empty_space = find_empty_space(widg);
     const auto y_begin     = empty_space.offset().y;
@@ -102,7 +180,7 @@ void Screen::paint_empty_tiles(const Widget& widg)
     for (auto y = y_begin; y < y_end; ++y) {
         for (auto x = x_begin; x < x_end; ++x) {
             if (empty_space.at(x, y)) {
-                output::put(x, y, wallpaper);
+                layers.put(layer, x, y, wallpaper);
             }
         }
     }
@@ -111,13 +189,15 @@ void Screen::paint_empty_tiles(const Widget& widg)
 void Screen::cover_leftovers(Widget& widg,
                              const Screen_descriptor& staged_tiles)
 {
+    auto& layers          = Layers::get();
+    const auto layer      = layers.layer_of(widg);
     const auto& wallpaper = widg.generate_wallpaper();
     auto& existing_tiles  = widg.screen_state().tiles;
     for (auto iter = std::begin(existing_tiles);
          iter != std::end(existing_tiles);) {
         const auto& point = iter->first;
         if (!contains(point, staged_tiles)) {
-            output::put(point.x, point.y, wallpaper);
+            layers.put(layer, point.x, point.y, wallpaper);
             iter = existing_tiles.erase(iter);
         }
         else {
@@ -128,12 +208,14 @@ void Screen::cover_leftovers(Widget& widg,
 
 void Screen::full_paint_single_point(Widget& widg,
                                      const Screen_descriptor& staged_tiles,
-                                     const Point& point)
+                                     const Point& point,
+                                     std::size_t layer,
+                                     const Glyph& wallpaper)
 {
     auto& existing_tiles = widg.screen_state().tiles;
     if (!contains(point, staged_tiles)) {
         if (!has_children(widg)) {
-            output::put(point.x, point.y, widg.generate_wallpaper());
+            Layers::get().put(layer, point.x, point.y, wallpaper);
             existing_tiles.erase(point);
         }
         return;
@@ -142,19 +224,20 @@ void Screen::full_paint_single_point(Widget& widg,
     imprint(widg.brush, tile.brush);
     // if (!(contains(point, existing_tiles) && existing_tiles[point] == tile))
     // {
-    output::put(point.x, point.y, tile);
+    Layers::get().put(layer, point.x, point.y, tile);
     existing_tiles[point] = tile;
     // }
 }
 
 void Screen::basic_paint_single_point(Widget& widg,
                                       const Point& point,
-                                      Glyph tile)
+                                      Glyph tile,
+                                      std::size_t layer)
 {
     imprint(widg.brush, tile.brush);
     auto& existing_tiles = widg.screen_state().tiles;
     if (!(contains(point, existing_tiles) && existing_tiles[point] == tile)) {
-        output::put(point.x, point.y, tile);
+        Layers::get().put(layer, point.x, point.y, tile);
         existing_tiles[point] = tile;
     }
 }
@@ -162,13 +245,16 @@ void Screen::basic_paint_single_point(Widget& widg,
 void Screen::full_paint(Widget& widg, const Screen_descriptor& staged_tiles)
 {
     paint_empty_tiles(widg);
-    const auto y_begin = widg.y();
-    const auto x_begin = widg.x();
-    const auto y_end   = y_begin + widg.outer_height();
-    const auto x_end   = x_begin + widg.outer_width();
+    const auto layer     = Layers::get().layer_of(widg);
+    const auto wallpaper = widg.generate_wallpaper();
+    const auto y_begin   = widg.y();
+    const auto x_begin   = widg.x();
+    const auto y_end     = y_begin + widg.outer_height();
+    const auto x_end     = x_begin + widg.outer_width();
     for (auto y = y_begin; y < y_end; ++y) {
         for (auto x = x_begin; x < x_end; ++x) {
-            full_paint_single_point(widg, staged_tiles, Point{x, y});
+            full_paint_single_point(widg, staged_tiles, Point{x, y}, layer,
+                                    wallpaper);
         }
     }
 }
@@ -176,8 +262,10 @@ void Screen::full_paint(Widget& widg, const Screen_descriptor& staged_tiles)
 void Screen::basic_paint(Widget& widg, const Screen_descriptor& staged_tiles)
 {
     cover_leftovers(widg, staged_tiles);
+    const auto layer = Layers::get().layer_of(widg);
     for (const auto& point_tile : staged_tiles) {
-        basic_paint_single_point(widg, point_tile.first, point_tile.second);
+        basic_paint_single_point(widg, point_tile.first, point_tile.second,
+                                 layer);
     }
 }
 
@@ -199,28 +287,134 @@ void Screen::paint_resize_event(Widget& widg,
 {
     paint_empty_tiles(widg);
     cover_leftovers(widg, staged_tiles);
-    const auto& new_space = widg.screen_state().optimize.resize_mask;
-    const auto y_begin    = new_space.offset().y;
-    const auto x_begin    = new_space.offset().x;
-    const auto y_end      = y_begin + new_space.area().height;
-    const auto x_end      = x_begin + new_space.area().width;
+    const auto layer     = Layers::get().layer_of(widg);
+    const auto wallpaper = widg.generate_wallpaper();
+    const auto& exposed  = widg.screen_state().optimize.resize_mask;
+    const Rect outer{Point{widg.x(), widg.y()},
+                     Area{widg.outer_width(), widg.outer_height()}};
+    const auto is_exposed = [&exposed](std::size_t x, std::size_t y) {
+        return std::any_of(std::begin(exposed), std::end(exposed),
+                           [x, y](const Rect& r) { return r.contains(x, y); });
+    };
+    // Exposed space was not on screen, it is painted in full.
+    for (const auto& rect : exposed) {
+        const auto y_end = rect.position.y + rect.size.height;
+        const auto x_end = rect.position.x + rect.size.width;
+        for (auto y = rect.position.y; y < y_end; ++y) {
+            for (auto x = rect.position.x; x < x_end; ++x) {
+                if (outer.contains(x, y)) {
+                    full_paint_single_point(widg, staged_tiles, Point{x, y},
+                                            layer, wallpaper);
+                }
+            }
+        }
+    }
+    // Space that was already on screen only needs what has changed.
+    for (const auto& point_tile : staged_tiles) {
+        const auto& point = point_tile.first;
+        if (!is_exposed(point.x, point.y)) {
+            basic_paint_single_point(widg, point, point_tile.second, layer);
+        }
+    }
+}
+
+void Screen::paint_scroll(Widget& widg, const Screen_descriptor& staged_tiles)
+{
+    const auto rows      = widg.screen_state().optimize.scrolled;
+    const auto magnitude = static_cast<std::size_t>(rows < 0 ? -rows : rows);
+    const auto x_begin   = widg.inner_x();
+    const auto y_begin   = widg.inner_y();
+    const auto x_end     = x_begin + widg.width();
+    const auto y_end     = y_begin + widg.height();
+    auto& layers         = Layers::get();
+    const auto layer     = layers.layer_of(widg);
+    if (has_children(widg) || magnitude >= widg.height() ||
+        !layers.shift_rows(layer, x_begin, y_begin,
+                       Area{widg.width(), widg.height()}, rows)) {
+        basic_paint(widg, staged_tiles);
+        return;
+    }
+    // Existing tiles in the inner area are now on screen at their new row.
+    auto& existing_tiles = widg.screen_state().tiles;
+    Screen_descriptor shifted;
+    shifted.reserve(existing_tiles.size());
+    for (const auto& point_tile : existing_tiles) {
+        auto point = point_tile.first;
+        if (point.x >= x_begin && point.x < x_end && point.y >= y_begin &&
+            point.y < y_end) {
+            const auto y = static_cast<long>(point.y) - rows;
+            if (y < static_cast<long>(y_begin) || y >= static_cast<long>(y_end))
+                continue;
+            point.y = static_cast<std::size_t>(y);
+        }
+        shifted.emplace(point, point_tile.second);
+    }
+    existing_tiles = std::move(shifted);
+    // Rows shifted in are blank on the terminal, give them the wallpaper.
+    const auto wallpaper     = widg.generate_wallpaper();
+    const auto exposed_begin = rows > 0 ? y_end - magnitude : y_begin;
+    const auto exposed_end   = exposed_begin + magnitude;
+    for (auto y = exposed_begin; y < exposed_end; ++y) {
+        for (auto x = x_begin; x < x_end; ++x) {
+            if (!contains(Point{x, y}, staged_tiles))
+                layers.put(layer, x, y, wallpaper);
+        }
+    }
+    basic_paint(widg, staged_tiles);
+}
+
+void Screen::paint_move_event(Widget& widg,
+                              const Screen_descriptor& staged_tiles)
+{
+    paint_empty_tiles(widg);
+    auto& layers         = Layers::get();
+    const auto layer     = layers.layer_of(widg);
+    const auto wallpaper = widg.generate_wallpaper();
+    const auto children  = has_children(widg);
+    auto& existing_tiles = widg.screen_state().tiles;
+    existing_tiles.clear();
+    const auto y_begin = widg.y();
+    const auto x_begin = widg.x();
+    const auto y_end   = y_begin + widg.outer_height();
+    const auto x_end   = x_begin + widg.outer_width();
     for (auto y = y_begin; y < y_end; ++y) {
         for (auto x = x_begin; x < x_end; ++x) {
-            const Point point{x, y};
-            if (new_space.at(x, y)) {
-                full_paint_single_point(widg, staged_tiles, point);
+            const auto at = staged_tiles.find(Point{x, y});
+            Glyph tile;
+            if (at != std::end(staged_tiles)) {
+                tile = at->second;
+                imprint(widg.brush, tile.brush);
+                existing_tiles.emplace(Point{x, y}, tile);
+            }
+            else if (children) {
+                continue;
+            }
+            else {
+                tile = wallpaper;
             }
-            else if (contains(point, staged_tiles)) {
-                basic_paint_single_point(widg, point, staged_tiles.at(point));
+            // Moving over itself, or over matching wallpaper, costs nothing.
+            if (!layers.holds(layer, x, y, tile)) {
+                layers.put(layer, x, y, tile);
             }
         }
     }
 }
 
-void Screen::paint_move_event(Widget& widg,
-                              const Screen_descriptor& staged_tiles)
+void Screen::paint_partial(Widget& widg, const Screen_descriptor& staged_tiles)
 {
-    full_paint(widg, staged_tiles);
+    auto& layers          = Layers::get();
+    const auto layer      = layers.layer_of(widg);
+    const auto& wallpaper = widg.generate_wallpaper();
+    auto& state           = widg.screen_state();
+    for (const auto& point : state.optimize.erased) {
+        if (state.tiles.erase(point) > 0) {
+            layers.put(layer, point.x, point.y, wallpaper);
+        }
+    }
+    for (const auto& point_tile : staged_tiles) {
+        basic_paint_single_point(widg, point_tile.first, point_tile.second,
+                                 layer);
+    }
 }
 
 void Screen::delegate_paint(Widget& widg, const Screen_descriptor& staged_tiles)
@@ -228,6 +422,24 @@ void Screen::delegate_paint(Widget& widg, const Screen_descriptor& staged_tiles)
     auto& optimization_info       = widg.screen_state().optimize;
     auto& previous_wallpaper      = optimization_info.wallpaper;
     const auto& current_wallpaper = widg.generate_wallpaper();
+    const bool only_changes =
+        !optimization_info.just_enabled && !optimization_info.moved &&
+        !optimization_info.resized && !optimization_info.child_event &&
+        optimization_info.scrolled == 0 &&
+        has_same_display(current_wallpaper, previous_wallpaper);
+    if (optimization_info.partial && only_changes) {
+        paint_partial(widg, staged_tiles);
+        optimization_info.reset();
+        return;
+    }
+    if (optimization_info.partial) {
+        // Other optimizations need the Widget's complete appearance.
+        const auto tiles          = complete(widg, staged_tiles);
+        optimization_info.partial = false;
+        optimization_info.erased.clear();
+        delegate_paint(widg, tiles);
+        return;
+    }
     if (optimization_info.just_enabled) {
         paint_just_enabled(widg, staged_tiles);
     }
@@ -238,12 +450,14 @@ void Screen::delegate_paint(Widget& widg, const Screen_descriptor& staged_tiles)
         paint_move_event(widg, staged_tiles);
     }
     else if (optimization_info.resized) {
-        // paint_resize_event(widg, staged_tiles);
-        full_paint(widg, staged_tiles);
+        paint_resize_event(widg, staged_tiles);
     }
     else if (optimization_info.child_event) {
         paint_child_event(widg, staged_tiles);
     }
+    else if (optimization_info.scrolled != 0) {
+        paint_scroll(widg, staged_tiles);
+    }
     else {
         basic_paint(widg, staged_tiles);
     }
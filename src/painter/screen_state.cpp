@@ -1,7 +1,5 @@
 #include <cppurses/painter/detail/screen_state.hpp>
 
-#include <cppurses/painter/detail/screen_mask.hpp>
-
 namespace cppurses {
 namespace detail {
 
@@ -10,8 +8,10 @@ void Screen_state::Optimize::reset() {
     this->moved = false;
     this->resized = false;
     this->child_event = false;
-    this->move_mask.clear();
+    this->scrolled = 0;
     this->resize_mask.clear();
+    this->partial = false;
+    this->erased.clear();
 }
 
 }  // namespace detail
@@ -14,7 +14,21 @@ auto Event_loop::run() -> int
 {
     if (running_)
         return -1;
-    exit_       = false;
+    exit_ = false;
+    return this->loop();
+}
+
+auto Event_loop::run_async() -> void
+{
+    this->wait();
+    // Reset before the thread starts, so an exit() called right after this
+    // returns is not lost.
+    exit_ = false;
+    fut_  = std::async(std::launch::async, [this] { return this->loop(); });
+}
+
+auto Event_loop::loop() -> int
+{
     running_    = true;
     auto notify = true;
     while (!exit_) {
@@ -28,11 +42,6 @@ auto Event_loop::run() -> int
     return return_code_;
 }
 
-auto Event_loop::run_async() -> void
-{
-    fut_ = std::async(std::launch::async, [this] { return this->run(); });
-}
-
 auto Event_loop::wait() -> int
 {
     if (fut_.valid())
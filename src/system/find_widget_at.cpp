@@ -4,6 +4,8 @@
 #include <memory>
 #include <vector>
 
+#include <cppurses/painter/detail/layers.hpp>
+#include <cppurses/painter/detail/offscreen_host.hpp>
 #include <cppurses/system/system.hpp>
 #include <cppurses/widget/children_data.hpp>
 #include <cppurses/widget/widget.hpp>
@@ -26,13 +28,27 @@ bool has_coordinates(const cppurses::Widget& w,
 namespace cppurses {
 namespace detail {
 
-Widget* find_widget_at(std::size_t x, std::size_t y) {
-    Widget* widg = System::head();
+Widget* find_widget_at(std::size_t& x, std::size_t& y) {
+    Widget* widg = Layers::get().overlay_at(x, y);
+    if (widg != nullptr) {
+        // Overlays block input to anything underneath, borders included.
+        if (!has_coordinates(*widg, x, y)) {
+            return widg;
+        }
+    } else {
+        widg = System::head();
+    }
     if (widg == nullptr || !has_coordinates(*widg, x, y)) {
         return nullptr;
     }
     bool keep_going = true;
     while (keep_going && !widg->children.get().empty()) {
+        // Children of a host are found at their virtual coordinates.
+        if (const auto* host = Offscreen_host::as_host(*widg)) {
+            const auto offset = host->scroll_offset();
+            x += offset.x;
+            y += offset.y;
+        }
         for (const auto& child : widg->children.get()) {
             if (has_coordinates(*child, x, y) && child->enabled()) {
                 widg = child.get();
@@ -0,0 +1,71 @@
+#include <cppurses/system/mapped_file.hpp>
+
+#include <cstddef>
+#include <string>
+#include <utility>
+
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+namespace cppurses {
+
+Mapped_file::Mapped_file(const std::string& filename)
+{
+    const int fd = ::open(filename.c_str(), O_RDONLY);
+    if (fd == -1)
+        return;
+    struct stat status;
+    if (::fstat(fd, &status) == 0 && S_ISREG(status.st_mode)) {
+        size_    = static_cast<std::size_t>(status.st_size);
+        is_open_ = true;
+        if (size_ != 0) {
+            void* mapped =
+                ::mmap(nullptr, size_, PROT_READ, MAP_PRIVATE, fd, 0);
+            if (mapped == MAP_FAILED) {
+                size_    = 0;
+                is_open_ = false;
+            }
+            else {
+                data_ = static_cast<const char*>(mapped);
+                ::madvise(mapped, size_, MADV_SEQUENTIAL);
+            }
+        }
+    }
+    // The mapping stays valid after the descriptor is closed.
+    ::close(fd);
+}
+
+Mapped_file::Mapped_file(Mapped_file&& other) noexcept
+    : data_{other.data_}, size_{other.size_}, is_open_{other.is_open_}
+{
+    other.data_    = nullptr;
+    other.size_    = 0;
+    other.is_open_ = false;
+}
+
+Mapped_file& Mapped_file::operator=(Mapped_file&& other) noexcept
+{
+    if (this != &other) {
+        this->unmap();
+        data_    = std::exchange(other.data_, nullptr);
+        size_    = std::exchange(other.size_, 0);
+        is_open_ = std::exchange(other.is_open_, false);
+    }
+    return *this;
+}
+
+Mapped_file::~Mapped_file()
+{
+    this->unmap();
+}
+
+void Mapped_file::unmap()
+{
+    if (data_ != nullptr)
+        ::munmap(const_cast<char*>(data_), size_);
+    data_ = nullptr;
+}
+
+}  // namespace cppurses
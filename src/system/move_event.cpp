@@ -1,23 +1,50 @@
 #include <cppurses/system/events/move_event.hpp>
 
+#include <utility>
+
 #include <cppurses/painter/detail/screen_descriptor.hpp>
-#include <cppurses/painter/detail/screen_mask.hpp>
 #include <cppurses/painter/detail/screen_state.hpp>
+#include <cppurses/painter/detail/staged_changes.hpp>
 #include <cppurses/system/event.hpp>
 #include <cppurses/widget/point.hpp>
 #include <cppurses/widget/widget.hpp>
 
+namespace {
+using namespace cppurses;
+
+/// Return \p tiles with each Point moved from \p old_position to \p position.
+detail::Screen_descriptor translate(const detail::Screen_descriptor& tiles,
+                                    Point old_position,
+                                    Point position) {
+    detail::Screen_descriptor moved;
+    moved.reserve(tiles.size());
+    for (const auto& point_tile : tiles) {
+        const auto& p = point_tile.first;
+        moved.emplace(Point{p.x - old_position.x + position.x,
+                            p.y - old_position.y + position.y},
+                      point_tile.second);
+    }
+    return moved;
+}
+
+}  // namespace
+
 namespace cppurses {
 
 bool Move_event::send() const {
     if (receiver_.x() != new_position_.x || receiver_.y() != new_position_.y) {
-        receiver_.screen_state().optimize.moved = true;
-        // Create and set move_mask in receiver_.screen_state()
-        receiver_.screen_state().optimize.move_mask =
-            detail::Screen_mask(receiver_, detail::Screen_mask::Outer);
-        receiver_.screen_state()
-            .tiles.clear();  // TODO remove this once opt impl.
         const Point old_position{receiver_.x(), receiver_.y()};
+        auto& state = receiver_.screen_state();
+        state.optimize.moved = true;
+        state.tiles = translate(state.tiles, old_position, new_position_);
+        // Painting is relative to the Widget, so what it last painted is still
+        // correct at the new position, and is staged in place of a repaint.
+        auto& staged = detail::Staged_changes::get()[&receiver_];
+        if (staged.empty()) {
+            staged = state.tiles;
+        } else {
+            staged = translate(staged, old_position, new_position_);
+        }
         receiver_.set_x(new_position_.x);
         receiver_.set_y(new_position_.y);
         return receiver_.move_event(new_position_, old_position);
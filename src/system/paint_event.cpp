@@ -0,0 +1,52 @@
+#include <cppurses/system/events/paint_event.hpp>
+
+#include <utility>
+
+#include <cppurses/painter/detail/is_paintable.hpp>
+#include <cppurses/painter/detail/screen_descriptor.hpp>
+#include <cppurses/painter/detail/screen_state.hpp>
+#include <cppurses/painter/detail/staged_changes.hpp>
+#include <cppurses/widget/widget.hpp>
+
+namespace cppurses {
+
+bool Paint_event::send() const {
+    if (!detail::is_paintable(receiver_)) {
+        return false;
+    }
+    auto& optimize = receiver_.screen_state().optimize;
+    auto& changes = detail::Staged_changes::get();
+    const bool was_staged = changes.count(&receiver_) > 0;
+    auto& staged = changes[&receiver_];
+    detail::Screen_descriptor previous;
+    previous.swap(staged);
+    auto previous_erased = std::move(optimize.erased);
+    const bool was_partial = optimize.partial;
+    optimize.partial = false;
+    optimize.erased.clear();
+    const bool result = receiver_.paint_event();
+    if (!optimize.partial || !was_staged) {
+        return result;
+    }
+    // Changes are relative to the previous paint, which was not flushed yet.
+    for (auto& point_tile : previous) {
+        if (optimize.erased.count(point_tile.first) == 0) {
+            staged.insert(std::move(point_tile));
+        }
+    }
+    if (was_partial) {
+        for (const auto& point : previous_erased) {
+            if (staged.count(point) == 0) {
+                optimize.erased.insert(point);
+            }
+        }
+    }
+    else {
+        // The previous paint was complete, and so are the combined changes.
+        optimize.partial = false;
+        optimize.erased.clear();
+    }
+    return result;
+}
+
+}  // namespace cppurses
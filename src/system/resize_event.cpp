@@ -1,13 +1,13 @@
 #include <cppurses/system/events/resize_event.hpp>
 
+#include <algorithm>
 #include <cstddef>
 #include <iterator>
 #include <unordered_map>
-#include <utility>
 #include <vector>
 
+#include <cppurses/painter/detail/rect.hpp>
 #include <cppurses/painter/detail/screen_descriptor.hpp>
-#include <cppurses/painter/detail/screen_mask.hpp>
 #include <cppurses/painter/detail/screen_state.hpp>
 #include <cppurses/system/event.hpp>
 #include <cppurses/widget/area.hpp>
@@ -18,36 +18,25 @@ namespace {
 using namespace cppurses;
 using namespace cppurses::detail;
 
-Screen_mask build_resize_mask(const Widget& w,
-                              const Area& old_size,
-                              const Area& new_size) {
+/// Append the regions of \p w that \p new_size exposes to \p exposed.
+void add_exposed(const Widget& w,
+                 const Area& old_size,
+                 const Area& new_size,
+                 std::vector<Rect>& exposed) {
     // w has been resized at this point, Areas are in outer_... form.
-    Screen_mask mask{w, Screen_mask::Outer};
-    // Width
+    // Width, the full height of the new columns.
     if (new_size.width > old_size.width) {
-        const auto y_begin = w.y();
-        const auto x_begin = w.x() + old_size.width;
-        const auto y_end = y_begin + new_size.height;
-        const auto x_end = w.x() + new_size.width;
-        for (auto y = y_begin; y < y_end; ++y) {
-            for (auto x = x_begin; x < x_end; ++x) {
-                mask.at(x, y) = true;
-            }
-        }
+        exposed.push_back(
+            Rect{Point{w.x() + old_size.width, w.y()},
+                 Area{new_size.width - old_size.width, new_size.height}});
     }
-    // Height
+    // Height, the new rows not already covered by the new columns.
     if (new_size.height > old_size.height) {
-        const auto y_begin = w.y() + old_size.height;
-        const auto x_begin = w.x();
-        const auto y_end = w.y() + new_size.height;
-        const auto x_end = w.x() + new_size.width;
-        for (auto y = y_begin; y < y_end; ++y) {
-            for (auto x = x_begin; x < x_end; ++x) {
-                mask.at(x, y) = true;
-            }
-        }
+        exposed.push_back(
+            Rect{Point{w.x(), w.y() + old_size.height},
+                 Area{std::min(old_size.width, new_size.width),
+                      new_size.height - old_size.height}});
     }
-    return mask;
 }
 }  // namespace
 
@@ -77,9 +66,9 @@ bool Resize_event::send() const {
         }
     }
 
-    // Create resize_mask for screen_state.optimize
-    detail::Screen_mask mask{build_resize_mask(receiver_, old_area, new_area_)};
-    receiver_.screen_state().optimize.resize_mask = std::move(mask);
+    // Record newly exposed space, there can be many resizes before a flush.
+    add_exposed(receiver_, old_area, new_area_,
+                receiver_.screen_state().optimize.resize_mask);
 
     return receiver_.resize_event(new_area_, old_area);
 }
@@ -1,6 +1,7 @@
 #include <cppurses/system/system.hpp>
 
 #include <algorithm>
+#include <cstddef>
 #include <iterator>
 #include <memory>
 #include <mutex>
@@ -11,6 +12,7 @@
 
 #include <signals/slot.hpp>
 
+#include <cppurses/painter/detail/layers.hpp>
 #include <cppurses/painter/palette.hpp>
 #include <cppurses/system/animation_engine.hpp>
 #include <cppurses/system/detail/event_engine.hpp>
@@ -19,11 +21,13 @@
 #include <cppurses/system/event.hpp>
 #include <cppurses/system/event_loop.hpp>
 #include <cppurses/system/events/focus_event.hpp>
+#include <cppurses/system/events/move_event.hpp>
 #include <cppurses/system/events/resize_event.hpp>
 #include <cppurses/system/focus.hpp>
 #include <cppurses/system/system.hpp>
 #include <cppurses/terminal/terminal.hpp>
 #include <cppurses/widget/area.hpp>
+#include <cppurses/widget/point.hpp>
 #include <cppurses/widget/widget.hpp>
 
 namespace cppurses {
@@ -50,6 +54,11 @@ void System::exit(int exit_code)
 
 System::~System() { System::exit(0); }
 
+void System::set_frame_rate(std::size_t fps)
+{
+    detail::Event_engine::get().set_frame_rate(fps);
+}
+
 void System::set_head(Widget* new_head)
 {
     if (head_ != nullptr)
@@ -62,6 +71,37 @@ void System::set_head(Widget* new_head)
     }
 }
 
+void System::open_overlay(Widget& overlay, Point position, Area size)
+{
+    if (overlay.parent() != nullptr)
+        return;
+    detail::Layers::get().add(overlay);
+    post_event<Move_event>(overlay, position);
+    post_event<Resize_event>(overlay, size);
+    overlay.enable();
+}
+
+void System::move_overlay(Widget& overlay, Point position)
+{
+    if (detail::Layers::get().is_overlay(overlay))
+        post_event<Move_event>(overlay, position);
+}
+
+void System::close_overlay(Widget& overlay)
+{
+    auto& layers = detail::Layers::get();
+    if (!layers.is_overlay(overlay))
+        return;
+    layers.remove(overlay);
+    for (Widget* w = Focus::focus_widget(); w != nullptr; w = w->parent()) {
+        if (w == &overlay) {
+            Focus::clear();
+            break;
+        }
+    }
+    overlay.disable();
+}
+
 int System::run(Widget& head)
 {
     System::set_head(&head);
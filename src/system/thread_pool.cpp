@@ -0,0 +1,69 @@
+#include <cppurses/system/thread_pool.hpp>
+
+#include <algorithm>
+#include <cstddef>
+#include <functional>
+#include <mutex>
+#include <thread>
+#include <utility>
+
+namespace cppurses {
+
+Thread_pool::Thread_pool(std::size_t thread_count)
+{
+    thread_count = std::max(thread_count, std::size_t{1});
+    workers_.reserve(thread_count);
+    for (std::size_t i{0}; i < thread_count; ++i)
+        workers_.emplace_back([this] { this->run(); });
+}
+
+Thread_pool::~Thread_pool()
+{
+    {
+        std::lock_guard<std::mutex> lock{mtx_};
+        stop_ = true;
+        tasks_.clear();
+    }
+    task_available_.notify_all();
+    for (auto& worker : workers_)
+        worker.join();
+}
+
+void Thread_pool::submit(std::function<void()> task)
+{
+    {
+        std::lock_guard<std::mutex> lock{mtx_};
+        tasks_.push_back(std::move(task));
+    }
+    task_available_.notify_one();
+}
+
+void Thread_pool::clear()
+{
+    std::lock_guard<std::mutex> lock{mtx_};
+    tasks_.clear();
+}
+
+std::size_t Thread_pool::default_thread_count()
+{
+    return std::max(std::thread::hardware_concurrency(), 1u);
+}
+
+void Thread_pool::run()
+{
+    while (true) {
+        std::function<void()> task;
+        {
+            std::unique_lock<std::mutex> lock{mtx_};
+            task_available_.wait(lock,
+                                 [this] { return stop_ || !tasks_.empty(); });
+            if (stop_)
+                return;
+            task = std::move(tasks_.front());
+            tasks_.pop_front();
+        }
+        task();
+    }
+}
+
+}  // namespace cppurses
@@ -1,18 +1,24 @@
 #include <cppurses/system/detail/user_input_event_loop.hpp>
 
+#include <algorithm>
 #include <memory>
 #include <utility>
 
+#include <cppurses/system/detail/event_engine.hpp>
 #include <cppurses/system/event.hpp>
 #include <cppurses/system/system.hpp>
 #include <cppurses/terminal/input.hpp>
+#include <cppurses/terminal/terminal.hpp>
 
 namespace cppurses {
 namespace detail {
 
 auto User_input_event_loop::loop_function() -> bool
 {
-    auto event = input::get();
+    // Wake up in time to flush a frame held back by the frame rate.
+    const auto timeout = std::min(System::terminal.refresh_rate(),
+                                  Event_engine::get().time_to_next_frame());
+    auto event = input::get(timeout);
     if (event == nullptr)
         return false;
     System::post_event(std::move(event));
@@ -1,5 +1,6 @@
 #include <cppurses/terminal/input.hpp>
 
+#include <chrono>
 #include <cstddef>
 #include <memory>
 #include <utility>
@@ -90,15 +91,15 @@ auto make_mouse_event() -> std::unique_ptr<Event>
     auto mouse_event = ::MEVENT{};
     if (::getmouse(&mouse_event) != OK)
         return nullptr;
-    Widget* receiver = detail::find_widget_at(mouse_event.x, mouse_event.y);
-    if (receiver == nullptr)
-        return nullptr;
-
     // Coordinates
     const auto global = Point{static_cast<std::size_t>(mouse_event.x),
                               static_cast<std::size_t>(mouse_event.y)};
-    const auto local =
-        Point{global.x - receiver->inner_x(), global.y - receiver->inner_y()};
+    auto x           = global.x;
+    auto y           = global.y;
+    Widget* receiver = detail::find_widget_at(x, y);
+    if (receiver == nullptr)
+        return nullptr;
+    const auto local = Point{x - receiver->inner_x(), y - receiver->inner_y()};
 
     // Create Event
     const auto type_button = extract_info(mouse_event);
@@ -150,5 +151,11 @@ auto get() -> std::unique_ptr<Event>
     }
 }
 
+auto get(std::chrono::milliseconds timeout) -> std::unique_ptr<Event>
+{
+    ::timeout(static_cast<int>(timeout.count()));
+    return get();
+}
+
 }  // namespace input
 }  // namespace cppurses
@@ -141,6 +141,25 @@ void refresh() {
     ::wrefresh(::stdscr);
 }
 
+bool shift_rows(std::size_t x,
+                std::size_t y,
+                std::size_t width,
+                std::size_t height,
+                int rows) {
+    auto* region = ::derwin(::stdscr, static_cast<int>(height),
+                            static_cast<int>(width), static_cast<int>(y),
+                            static_cast<int>(x));
+    if (region == nullptr) {
+        return false;
+    }
+    ::scrollok(region, true);
+    const auto result = ::wscrl(region, rows);
+    // region shares its cells with stdscr, only the change markers are copied.
+    ::wsyncup(region);
+    ::delwin(region);
+    return result == OK;
+}
+
 void put(const Glyph& g) {
 #ifdef SLOW_PAINT
     paint_indicator('X');
@@ -33,12 +33,33 @@ extern "C" void handle_sigint(int /* sig*/)
 namespace {
 using namespace cppurses;
 
-Underlying_color_t scale(Underlying_color_t value)
+/// Maps RGB values [0, 255] onto the ncurses color range [0, 1000].
+class Scale_table {
+   public:
+    constexpr Scale_table()
+    {
+        for (int value{0}; value < size; ++value)
+            table_[value] = value * ncurses_max / value_max;
+    }
+
+    /// Return \p value scaled to ncurses range, out of range values clamp.
+    constexpr Underlying_color_t operator()(Underlying_color_t value) const
+    {
+        return table_[value < 0 ? 0 : (value > value_max ? value_max : value)];
+    }
+
+   private:
+    static constexpr int value_max{255};
+    static constexpr int ncurses_max{1000};
+    static constexpr int size{value_max + 1};
+    Underlying_color_t table_[size]{};
+};
+
+constexpr Scale_table scale;
+
+bool same_values(const RGB& x, const RGB& y)
 {
-    const auto value_max   = 255;
-    const auto ncurses_max = 1000;
-    return static_cast<Underlying_color_t>(
-        (static_cast<double>(value) / value_max) * ncurses_max);
+    return x.red == y.red && x.green == y.green && x.blue == y.blue;
 }
 }  // namespace
 
@@ -59,6 +80,8 @@ void Terminal::initialize()
     is_initialized_ = true;
     ::noecho();
     ::keypad(::stdscr, true);
+    // Lets ncurses turn shifted lines into terminal scroll operations.
+    ::idlok(::stdscr, true);
     ::ESCDELAY = 1;
     ::mousemask(ALL_MOUSE_EVENTS, nullptr);
     ::mouseinterval(0);
@@ -117,9 +140,31 @@ void Terminal::set_background(const Glyph& tile)
 
 void Terminal::set_color_palette(const Palette& colors)
 {
-    palette_ = colors;
-    if (is_initialized_ && this->has_color())
-        this->ncurses_set_palette(palette_);
+    for (const Color_definition& def : colors)
+        this->set_color_definition(def);
+}
+
+void Terminal::set_color_definition(const Color_definition& definition)
+{
+    for (Color_definition& def : palette_) {
+        if (def.color != definition.color)
+            continue;
+        if (same_values(def.values, definition.values))
+            return;
+        def.values = definition.values;
+        if (is_initialized_ && this->has_color())
+            this->ncurses_set_color(def);
+        return;
+    }
+}
+
+RGB Terminal::color_values(Color color) const
+{
+    for (const Color_definition& def : palette_) {
+        if (def.color == color)
+            return def.values;
+    }
+    return RGB{0, 0, 0};
 }
 
 void Terminal::show_cursor(bool show)
@@ -197,16 +242,21 @@ void Terminal::use_default_colors(bool use)
 
 void Terminal::ncurses_set_palette(const Palette& colors)
 {
-    if (this->can_change_colors()) {
-        for (const Color_definition& def : colors) {
-            const auto max_color = this->has_extended_colors() ? 16 : 8;
-            const auto ncurses_color_number =
-                static_cast<Underlying_color_t>(def.color);
-            if (ncurses_color_number < max_color) {
-                ::init_color(ncurses_color_number, scale(def.values.red),
-                             scale(def.values.green), scale(def.values.blue));
-            }
-        }
+    for (const Color_definition& def : colors)
+        this->ncurses_set_color(def);
+}
+
+void Terminal::ncurses_set_color(const Color_definition& definition)
+{
+    if (!this->can_change_colors())
+        return;
+    const auto max_color = this->has_extended_colors() ? 16 : 8;
+    const auto ncurses_color_number =
+        static_cast<Underlying_color_t>(definition.color);
+    if (ncurses_color_number < max_color) {
+        ::init_color(ncurses_color_number, scale(definition.values.red),
+                     scale(definition.values.green),
+                     scale(definition.values.blue));
     }
 }
 
@@ -0,0 +1,309 @@
+#include <cppurses/widget/widgets/file_picker.hpp>
+
+#include <dirent.h>
+#include <sys/stat.h>
+
+#include <algorithm>
+#include <cerrno>
+#include <chrono>
+#include <codecvt>
+#include <cstddef>
+#include <cstring>
+#include <iterator>
+#include <locale>
+#include <memory>
+#include <mutex>
+#include <stdexcept>
+#include <string>
+#include <utility>
+#include <vector>
+
+#include <cppurses/painter/attribute.hpp>
+#include <cppurses/painter/glyph_string.hpp>
+#include <cppurses/system/events/custom_event.hpp>
+#include <cppurses/system/system.hpp>
+
+namespace {
+
+/// Time spent reading before the entries read so far are posted anyway.
+constexpr auto batch_interval = std::chrono::milliseconds{50};
+
+/// Entries of a sorted listing added to the list per Event.
+/** Large listings are shown over several Events, so input is handled in
+ *  between. */
+constexpr std::size_t listing_chunk{4096};
+
+/// Return the path of \p name within \p directory, ".." goes up one level.
+std::string child_path(const std::string& directory, const std::string& name)
+{
+    if (name == "..") {
+        const auto slash = directory.find_last_of('/');
+        const auto last =
+            directory.substr(slash == std::string::npos ? 0 : slash + 1);
+        if (!last.empty() && last != "." && last != "..") {
+            if (slash == std::string::npos)
+                return ".";
+            return slash == 0 ? "/" : directory.substr(0, slash);
+        }
+    }
+    if (!directory.empty() && directory.back() == '/')
+        return directory + name;
+    return directory + '/' + name;
+}
+
+using Converter_t = std::wstring_convert<std::codecvt_utf8<wchar_t>>;
+
+/// Return \p name as a label, bytes that are not UTF-8 are shown one each.
+cppurses::Glyph_string make_label(Converter_t& converter,
+                                  const std::string& name,
+                                  bool is_directory)
+{
+    cppurses::Glyph_string label;
+    try {
+        label = cppurses::Glyph_string{converter.from_bytes(name)};
+    }
+    catch (const std::range_error&) {
+        for (unsigned char byte : name)
+            label.push_back(cppurses::Glyph{static_cast<wchar_t>(byte)});
+    }
+    if (is_directory)
+        label.push_back(cppurses::Glyph{L'/'});
+    return label;
+}
+
+}  // namespace
+
+namespace cppurses {
+
+File_picker::File_picker(std::string directory)
+{
+    this->set_name("File_picker");
+    path_display.brush.add_attributes(Attribute::Bold);
+    status.brush.add_attributes(Attribute::Dim);
+    entries.selected.connect([this](std::size_t index) { this->pick(index); });
+    this->set_directory(std::move(directory));
+}
+
+File_picker::~File_picker()
+{
+    ++generation_;
+    worker_.clear();
+}
+
+void File_picker::set_directory(std::string directory)
+{
+    const auto generation = ++generation_;
+    directory_ = std::move(directory);
+    scanning_ = true;
+    rescan_on_enable_ = false;
+    shown_.clear();
+    entries.clear();
+    entries.set_filter(L"");
+    if (directory_ != "/")
+        this->show_entry(Entry{"..", "../", true});
+    path_display.set_contents(directory_);
+    status.set_contents("Reading...");
+    worker_.clear();
+    worker_.submit(
+        [this, generation, directory = directory_, batch_size = batch_size_] {
+            this->scan(generation, directory, batch_size);
+        });
+    directory_changed(directory_);
+}
+
+void File_picker::set_batch_size(std::size_t size)
+{
+    batch_size_ = std::max(size, std::size_t{1});
+}
+
+bool File_picker::enable_event()
+{
+    // Batches posted while disabled were dropped, read the directory again.
+    if (rescan_on_enable_)
+        this->set_directory(directory_);
+    return layout::Vertical::enable_event();
+}
+
+bool File_picker::disable_event()
+{
+    if (scanning_) {
+        ++generation_;
+        rescan_on_enable_ = true;
+    }
+    return layout::Vertical::disable_event();
+}
+
+void File_picker::scan(std::size_t generation,
+                       const std::string& directory,
+                       std::size_t batch_size)
+{
+    struct stat info;
+    if (::stat(directory.c_str(), &info) != 0 || !S_ISDIR(info.st_mode)) {
+        this->post_error(generation, "Not a directory");
+        return;
+    }
+    {
+        std::lock_guard<std::mutex> lock{cache_mtx_};
+        const auto cached = listings_.find(directory);
+        if (cached != std::end(listings_) &&
+            cached->second.modified_seconds == info.st_mtim.tv_sec &&
+            cached->second.modified_nanoseconds == info.st_mtim.tv_nsec) {
+            this->post_listing(generation, cached->second.entries);
+            return;
+        }
+    }
+    DIR* dir = ::opendir(directory.c_str());
+    if (dir == nullptr) {
+        this->post_error(generation, std::strerror(errno));
+        return;
+    }
+    Entries_t all;
+    Entries_t batch;
+    Converter_t converter;
+    auto last_post = std::chrono::steady_clock::now();
+    while (const dirent* ent = ::readdir(dir)) {
+        if (generation_ != generation) {
+            ::closedir(dir);
+            return;
+        }
+        const std::string name{ent->d_name};
+        if (name == "." || name == "..")
+            continue;
+        bool is_directory{ent->d_type == DT_DIR};
+        // The type is only stat'd when readdir does not give it, or to find
+        // out what a symbolic link points to.
+        if (ent->d_type == DT_UNKNOWN || ent->d_type == DT_LNK) {
+            struct stat entry_info;
+            if (::fstatat(::dirfd(dir), ent->d_name, &entry_info, 0) == 0)
+                is_directory = S_ISDIR(entry_info.st_mode);
+        }
+        batch.push_back(Entry{name, make_label(converter, name, is_directory),
+                              is_directory});
+        const auto now = std::chrono::steady_clock::now();
+        if (batch.size() >= batch_size || now - last_post >= batch_interval) {
+            all.insert(std::end(all), std::begin(batch), std::end(batch));
+            this->post_entries(generation, std::move(batch));
+            batch.clear();
+            last_post = now;
+        }
+    }
+    ::closedir(dir);
+    all.insert(std::end(all), std::begin(batch), std::end(batch));
+    std::sort(std::begin(all), std::end(all),
+              [](const Entry& a, const Entry& b) {
+                  if (a.is_directory != b.is_directory)
+                      return a.is_directory;
+                  return a.name < b.name;
+              });
+    auto listing = std::make_shared<const Entries_t>(std::move(all));
+    {
+        std::lock_guard<std::mutex> lock{cache_mtx_};
+        listings_[directory] =
+            Listing{info.st_mtim.tv_sec, info.st_mtim.tv_nsec, listing};
+    }
+    this->post_listing(generation, std::move(listing));
+}
+
+void File_picker::post_entries(std::size_t generation, Entries_t batch)
+{
+    auto entries = std::make_shared<Entries_t>(std::move(batch));
+    System::post_event<Custom_event>(*this, [this, generation, entries] {
+        this->add_entries(generation, *entries);
+    });
+}
+
+void File_picker::post_listing(std::size_t generation,
+                               std::shared_ptr<const Entries_t> listing)
+{
+    System::post_event<Custom_event>(*this, [this, generation, listing] {
+        this->show_listing(generation, listing, 0);
+    });
+}
+
+void File_picker::post_error(std::size_t generation, std::string message)
+{
+    System::post_event<Custom_event>(*this, [this, generation, message] {
+        if (generation != generation_)
+            return;
+        scanning_ = false;
+        status.set_contents(message);
+    });
+}
+
+void File_picker::add_entries(std::size_t generation, const Entries_t& batch)
+{
+    if (generation != generation_)
+        return;
+    for (const Entry& entry : batch)
+        this->show_entry(entry);
+    status.set_contents("Reading... " + std::to_string(shown_.size()));
+}
+
+void File_picker::show_listing(std::size_t generation,
+                               std::shared_ptr<const Entries_t> listing,
+                               std::size_t first)
+{
+    if (generation != generation_)
+        return;
+    if (first == 0) {
+        const auto selected = entries.selected_item();
+        reselect_ =
+            selected < shown_.size() ? shown_[selected].name : std::string{};
+        const bool has_parent = !shown_.empty() && shown_.front().name == "..";
+        shown_.resize(has_parent ? 1 : 0);
+        entries.clear();
+        if (has_parent)
+            entries.append_item(shown_.front().label);
+    }
+    const auto last = std::min(first + listing_chunk, listing->size());
+    for (auto i = first; i < last; ++i)
+        this->show_entry((*listing)[i]);
+    if (last != listing->size()) {
+        System::post_event<Custom_event>(*this, [this, generation, listing,
+                                                 last] {
+            this->show_listing(generation, listing, last);
+        });
+        return;
+    }
+    // Keep the same entry selected as before the sorted listing replaced the
+    // entries streamed in.
+    const auto at = std::find_if(
+        std::begin(shown_), std::end(shown_),
+        [this](const Entry& e) { return e.name == reselect_; });
+    if (at != std::end(shown_))
+        entries.select_item(std::distance(std::begin(shown_), at));
+    scanning_ = false;
+    status.set_contents(std::to_string(listing->size()) + " entries");
+}
+
+void File_picker::show_entry(const Entry& entry)
+{
+    shown_.push_back(entry);
+    entries.append_item(entry.label);
+}
+
+void File_picker::pick(std::size_t index)
+{
+    if (index >= shown_.size())
+        return;
+    const Entry entry = shown_[index];
+    const auto path = child_path(directory_, entry.name);
+    if (entry.is_directory)
+        this->set_directory(path);
+    else
+        file_picked(path);
+}
+
+namespace slot {
+
+sig::Slot<void(std::string)> set_directory(File_picker& fp)
+{
+    sig::Slot<void(std::string)> slot{[&fp](std::string directory) {
+        fp.set_directory(std::move(directory));
+    }};
+    slot.track(fp.destroyed);
+    return slot;
+}
+
+}  // namespace slot
+}  // namespace cppurses
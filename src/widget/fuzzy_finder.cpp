@@ -0,0 +1,240 @@
+#include <cppurses/widget/widgets/fuzzy_finder.hpp>
+
+#include <algorithm>
+#include <cctype>
+#include <cstddef>
+#include <iterator>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <utility>
+#include <vector>
+
+#include <cppurses/painter/glyph_string.hpp>
+#include <cppurses/system/events/custom_event.hpp>
+#include <cppurses/system/events/key.hpp>
+#include <cppurses/system/system.hpp>
+#include <cppurses/widget/focus_policy.hpp>
+#include <cppurses/widget/widgets/detail/fuzzy_score.hpp>
+
+namespace {
+
+std::string to_lower(std::string text)
+{
+    std::transform(std::begin(text), std::end(text), std::begin(text),
+                   [](unsigned char c) { return std::tolower(c); });
+    return text;
+}
+
+/// Push \p match into the heap \p best if it is among the best \p limit.
+/** The front of \p best is the worst Match kept. */
+template <typename Match_t, typename Compare>
+void keep_best(std::vector<Match_t>& best,
+               const Match_t& match,
+               std::size_t limit,
+               Compare better)
+{
+    if (best.size() < limit) {
+        best.push_back(match);
+        std::push_heap(std::begin(best), std::end(best), better);
+    }
+    else if (limit != 0 && better(match, best.front())) {
+        std::pop_heap(std::begin(best), std::end(best), better);
+        best.back() = match;
+        std::push_heap(std::begin(best), std::end(best), better);
+    }
+}
+
+/// Higher scores first, earlier candidates break ties.
+template <typename Match_t>
+bool is_better(const Match_t& a, const Match_t& b)
+{
+    return a.score > b.score || (a.score == b.score && a.index < b.index);
+}
+
+}  // namespace
+
+namespace cppurses {
+
+Fuzzy_finder::Fuzzy_finder()
+{
+    this->set_name("Fuzzy_finder");
+    results.focus_policy = Focus_policy::None;
+    input.install_event_filter(*this);
+    input.contents_modified.connect([this](const Glyph_string& text) {
+        auto pattern = text.str();
+        if (pattern != pattern_)
+            this->start_search(std::move(pattern));
+    });
+    results.selected.connect(
+        [this](std::size_t row) { this->send_selected(row); });
+}
+
+Fuzzy_finder::~Fuzzy_finder()
+{
+    ++generation_;
+    pool_.clear();
+}
+
+void Fuzzy_finder::set_candidates(std::vector<std::string> candidates)
+{
+    candidates_ = std::make_shared<const Candidates_t>(std::move(candidates));
+    this->start_search(pattern_);
+}
+
+void Fuzzy_finder::set_result_limit(std::size_t limit)
+{
+    limit_ = limit;
+    this->start_search(pattern_);
+}
+
+void Fuzzy_finder::set_chunk_size(std::size_t size)
+{
+    chunk_size_ = std::max(size, std::size_t{1});
+}
+
+bool Fuzzy_finder::key_press_event_filter(Widget& receiver,
+                                          const Key::State& keyboard)
+{
+    if (&receiver != &input)
+        return false;
+    switch (keyboard.key) {
+        case Key::Arrow_up: results.select_up(); break;
+        case Key::Arrow_down: results.select_down(); break;
+        case Key::Previous_page: results.select_up(results.height()); break;
+        case Key::Next_page: results.select_down(results.height()); break;
+        case Key::Enter: this->send_selected(results.selected_item()); break;
+        default: return false;
+    }
+    return true;
+}
+
+bool Fuzzy_finder::enable_event()
+{
+    // A refresh Event is dropped if it arrives while this is disabled.
+    this->refresh_results();
+    return layout::Vertical::enable_event();
+}
+
+void Fuzzy_finder::start_search(std::string pattern)
+{
+    pattern_              = std::move(pattern);
+    const auto generation = ++generation_;
+    pool_.clear();
+    const auto lower      = to_lower(pattern_);
+    const auto candidates = candidates_;
+    const auto count      = candidates->size();
+    const auto chunks     = (count + chunk_size_ - 1) / chunk_size_;
+    {
+        std::lock_guard<std::mutex> lock{result_mtx_};
+        best_.clear();
+        matched_     = 0;
+        chunks_done_ = 0;
+        chunk_count_ = chunks;
+        if (lower.empty()) {
+            // Everything matches, in the original order.
+            for (std::size_t i{0}; i < std::min(limit_, count); ++i)
+                best_.push_back(Match{1, i});
+            std::make_heap(std::begin(best_), std::end(best_),
+                           is_better<Match>);
+            matched_     = count;
+            chunks_done_ = chunks;
+        }
+    }
+    if (lower.empty() || count == 0) {
+        this->refresh_results();
+        return;
+    }
+    pending_ = true;
+    for (std::size_t first{0}; first < count; first += chunk_size_) {
+        const auto last  = std::min(first + chunk_size_, count);
+        const auto limit = limit_;
+        pool_.submit([this, generation, lower, candidates, first, last, limit] {
+            this->score_chunk(generation, lower, *candidates, first, last,
+                              limit);
+        });
+    }
+    // Previous results stay displayed until the first chunk is merged.
+    status.set_contents(std::to_string(count) + " ...");
+}
+
+void Fuzzy_finder::score_chunk(std::size_t generation,
+                               const std::string& pattern,
+                               const Candidates_t& candidates,
+                               std::size_t first,
+                               std::size_t last,
+                               std::size_t limit)
+{
+    std::vector<Match> best;
+    best.reserve(limit);
+    std::size_t matched{0};
+    for (auto i = first; i < last; ++i) {
+        if ((i - first) % 4096 == 0 && generation_ != generation)
+            return;
+        const auto score = detail::fuzzy_score(pattern, candidates[i]);
+        if (score == 0)
+            continue;
+        ++matched;
+        keep_best(best, Match{score, i}, limit, is_better<Match>);
+    }
+    {
+        std::lock_guard<std::mutex> lock{result_mtx_};
+        if (generation_ != generation)
+            return;
+        for (const auto& match : best)
+            keep_best(best_, match, limit, is_better<Match>);
+        matched_ += matched;
+        ++chunks_done_;
+    }
+    this->post_refresh();
+}
+
+void Fuzzy_finder::post_refresh()
+{
+    if (!refresh_posted_.exchange(true)) {
+        System::post_event<Custom_event>(*this,
+                                         [this] { this->refresh_results(); });
+    }
+}
+
+void Fuzzy_finder::refresh_results()
+{
+    refresh_posted_ = false;
+    std::vector<Match> best;
+    std::size_t matched;
+    {
+        std::lock_guard<std::mutex> lock{result_mtx_};
+        best     = best_;
+        matched  = matched_;
+        pending_ = chunks_done_ < chunk_count_;
+    }
+    std::sort(std::begin(best), std::end(best), is_better<Match>);
+
+    // Keep the same candidate selected as results stream in.
+    const auto row = results.selected_item();
+    const auto previous =
+        row < shown_.size() ? shown_[row] : candidates_->size();
+    shown_.clear();
+    results.clear();
+    for (const auto& match : best) {
+        shown_.push_back(match.index);
+        results.append_item((*candidates_)[match.index]);
+    }
+    const auto at = std::find(std::begin(shown_), std::end(shown_), previous);
+    if (at != std::end(shown_))
+        results.select_item(std::distance(std::begin(shown_), at));
+
+    auto text = std::to_string(matched) + '/' +
+                std::to_string(candidates_->size());
+    if (pending_)
+        text.append(" ...");
+    status.set_contents(std::move(text));
+}
+
+void Fuzzy_finder::send_selected(std::size_t row)
+{
+    if (row < shown_.size())
+        selected((*candidates_)[shown_[row]]);
+}
+
+}  // namespace cppurses
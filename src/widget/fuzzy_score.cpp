@@ -0,0 +1,77 @@
+#include <cppurses/widget/widgets/detail/fuzzy_score.hpp>
+
+#include <algorithm>
+#include <cctype>
+#include <cstddef>
+#include <string>
+
+namespace {
+
+const int match_score{16};
+const int consecutive_bonus{24};
+const int word_start_bonus{24};
+const int camel_case_bonus{16};
+const int gap_start_penalty{4};
+const int max_gap_extension_penalty{8};
+
+bool is_separator(char c)
+{
+    return c == ' ' || c == '/' || c == '\\' || c == '_' || c == '-' ||
+           c == '.' || c == ':';
+}
+
+char lower(char c)
+{
+    return static_cast<char>(std::tolower(static_cast<unsigned char>(c)));
+}
+
+bool is_upper(char c) { return std::isupper(static_cast<unsigned char>(c)); }
+
+bool is_lower(char c) { return std::islower(static_cast<unsigned char>(c)); }
+
+}  // namespace
+
+namespace cppurses {
+namespace detail {
+
+int fuzzy_score(const std::string& pattern, const std::string& candidate)
+{
+    if (pattern.empty())
+        return 1;
+    if (pattern.size() > candidate.size())
+        return 0;
+    int score{0};
+    std::size_t p{0};
+    std::size_t previous{0};
+    for (std::size_t i{0}; i < candidate.size() && p < pattern.size(); ++i) {
+        const char c = candidate[i];
+        if (lower(c) != pattern[p])
+            continue;
+        score += match_score;
+        if (i == 0 || is_separator(candidate[i - 1]))
+            score += word_start_bonus;
+        else if (is_upper(c) && is_lower(candidate[i - 1]))
+            score += camel_case_bonus;
+        if (p != 0) {
+            const auto gap = i - previous - 1;
+            if (gap == 0) {
+                score += consecutive_bonus;
+            }
+            else {
+                score -= gap_start_penalty +
+                         static_cast<int>(std::min(
+                             gap - 1, std::size_t(max_gap_extension_penalty)));
+            }
+        }
+        previous = i;
+        ++p;
+    }
+    if (p != pattern.size())
+        return 0;
+    // Prefer shorter candidates among otherwise equal matches.
+    score -= static_cast<int>(std::min(candidate.size() / 16, std::size_t{8}));
+    return std::max(score, 1);
+}
+
+}  // namespace detail
+}  // namespace cppurses
@@ -1,8 +1,10 @@
 #include <cppurses/widget/widgets/matrix_display.hpp>
 
+#include <algorithm>
 #include <cstddef>
 
 #include <cppurses/painter/painter.hpp>
+#include <cppurses/widget/point.hpp>
 
 namespace cppurses {
 
@@ -16,18 +18,50 @@ Matrix_display::Matrix_display(std::size_t width, std::size_t height)
     this->set_name("Matrix_display");
 }
 
+void Matrix_display::set_offset(Point offset) {
+    const auto max = this->max_offset();
+    offset.x = std::min(offset.x, max.x);
+    offset.y = std::min(offset.y, max.y);
+    if (offset == offset_) {
+        return;
+    }
+    offset_ = offset;
+    this->update();
+}
+
+void Matrix_display::scroll_up(std::size_t n) {
+    const auto y = offset_.y > n ? offset_.y - n : 0;
+    this->set_offset(Point{offset_.x, y});
+}
+
+void Matrix_display::scroll_down(std::size_t n) {
+    this->set_offset(Point{offset_.x, offset_.y + n});
+}
+
+void Matrix_display::scroll_left(std::size_t n) {
+    const auto x = offset_.x > n ? offset_.x - n : 0;
+    this->set_offset(Point{x, offset_.y});
+}
+
+void Matrix_display::scroll_right(std::size_t n) {
+    this->set_offset(Point{offset_.x + n, offset_.y});
+}
+
 bool Matrix_display::paint_event() {
-    std::size_t w{matrix.width() > this->width() ? this->width()
-                                                 : matrix.width()};
-    std::size_t h{matrix.height() > this->height() ? this->height()
-                                                   : matrix.height()};
+    // matrix is public, it may have shrunk since the offset was set.
+    const auto max = this->max_offset();
+    offset_.x = std::min(offset_.x, max.x);
+    offset_.y = std::min(offset_.y, max.y);
     Painter p{*this};
-    for (std::size_t y{0}; y < h; ++y) {
-        for (std::size_t x{0}; x < w; ++x) {
-            p.put(matrix(x, y), x, y);
-        }
-    }
+    p.blit(matrix, offset_);
     return Widget::paint_event();
 }
 
+Point Matrix_display::max_offset() const {
+    const auto w = this->width();
+    const auto h = this->height();
+    return Point{matrix.width() > w ? matrix.width() - w : 0,
+                 matrix.height() > h ? matrix.height() - h : 0};
+}
+
 }  // namespace cppurses
@@ -0,0 +1,293 @@
+#include <cppurses/widget/widgets/scroll_area.hpp>
+
+#include <algorithm>
+#include <cstddef>
+#include <iterator>
+#include <memory>
+#include <utility>
+
+#include <cppurses/painter/brush.hpp>
+#include <cppurses/painter/detail/find_empty_space.hpp>
+#include <cppurses/painter/detail/screen_mask.hpp>
+#include <cppurses/painter/detail/screen_descriptor.hpp>
+#include <cppurses/painter/glyph.hpp>
+#include <cppurses/painter/painter.hpp>
+#include <cppurses/system/events/key.hpp>
+#include <cppurses/system/events/mouse.hpp>
+#include <cppurses/system/events/move_event.hpp>
+#include <cppurses/system/events/resize_event.hpp>
+#include <cppurses/system/system.hpp>
+#include <cppurses/widget/area.hpp>
+#include <cppurses/widget/focus_policy.hpp>
+#include <cppurses/widget/point.hpp>
+#include <cppurses/widget/size_policy.hpp>
+
+namespace {
+using namespace cppurses;
+
+/// Return the length \p policy asks for, given \p available viewport length.
+std::size_t full_length(const Size_policy& policy, std::size_t available)
+{
+    switch (policy.type()) {
+        case Size_policy::Fixed: return policy.hint();
+        case Size_policy::Maximum: return std::min(policy.hint(), available);
+        default:
+            return std::min(
+                std::max({policy.hint(), policy.min_size(), available}),
+                policy.max_size());
+    }
+}
+
+}  // namespace
+
+namespace cppurses {
+
+Scroll_area::Scroll_area()
+    : detail::Offscreen_host{static_cast<Widget&>(*this)}
+{
+    this->set_name("Scroll_area");
+    this->focus_policy = Focus_policy::Strong;
+}
+
+Scroll_area::~Scroll_area()
+{
+    // Descendants are destroyed after this object's members.
+    for (auto& widg_painted : painted_)
+        widg_painted.second.on_destroyed.disconnect();
+}
+
+Widget* Scroll_area::content() const
+{
+    const auto& children = this->children.get();
+    return children.empty() ? nullptr : children.front().get();
+}
+
+void Scroll_area::set_offset(Point offset)
+{
+    const auto max = this->max_offset();
+    offset.x       = std::min(offset.x, max.x);
+    offset.y       = std::min(offset.y, max.y);
+    if (offset == offset_)
+        return;
+    if (offset.x == offset_.x) {
+        this->screen_state().optimize.scrolled +=
+            static_cast<int>(offset.y) - static_cast<int>(offset_.y);
+    }
+    offset_ = offset;
+    this->update();
+}
+
+void Scroll_area::scroll_up(std::size_t n)
+{
+    const auto y = offset_.y > n ? offset_.y - n : 0;
+    this->set_offset(Point{offset_.x, y});
+}
+
+void Scroll_area::scroll_down(std::size_t n)
+{
+    this->set_offset(Point{offset_.x, offset_.y + n});
+}
+
+void Scroll_area::scroll_left(std::size_t n)
+{
+    const auto x = offset_.x > n ? offset_.x - n : 0;
+    this->set_offset(Point{x, offset_.y});
+}
+
+void Scroll_area::scroll_right(std::size_t n)
+{
+    this->set_offset(Point{offset_.x + n, offset_.y});
+}
+
+bool Scroll_area::paint_event()
+{
+    // Disabled descendants are not painted and do not stage their removal.
+    for (auto iter = std::begin(painted_); iter != std::end(painted_);) {
+        auto& descendant = *(iter++)->first;
+        if (!descendant.enabled())
+            this->erase(descendant);
+    }
+    Painter p{*this};
+    p.blit(canvas_, offset_);
+    return Widget::paint_event();
+}
+
+bool Scroll_area::move_event(Point new_position, Point old_position)
+{
+    this->update_geometry();
+    return Widget::move_event(new_position, old_position);
+}
+
+bool Scroll_area::resize_event(Area new_size, Area old_size)
+{
+    this->update_geometry();
+    return Widget::resize_event(new_size, old_size);
+}
+
+bool Scroll_area::child_added_event(Widget& child)
+{
+    if (&child == this->content())
+        this->update_geometry();
+    else
+        child.disable(true, false);
+    return Widget::child_added_event(child);
+}
+
+bool Scroll_area::child_polished_event(Widget& child)
+{
+    if (&child == this->content())
+        this->update_geometry();
+    return Widget::child_polished_event(child);
+}
+
+bool Scroll_area::mouse_press_event(const Mouse::State& mouse)
+{
+    if (mouse.button == Mouse::Button::ScrollUp)
+        this->scroll_up();
+    else if (mouse.button == Mouse::Button::ScrollDown)
+        this->scroll_down();
+    return Widget::mouse_press_event(mouse);
+}
+
+bool Scroll_area::key_press_event(const Key::State& keyboard)
+{
+    switch (keyboard.key) {
+        case Key::Arrow_up: this->scroll_up(); break;
+        case Key::Arrow_down: this->scroll_down(); break;
+        case Key::Arrow_left: this->scroll_left(); break;
+        case Key::Arrow_right: this->scroll_right(); break;
+        case Key::Previous_page: this->scroll_up(this->height()); break;
+        case Key::Next_page: this->scroll_down(this->height()); break;
+        default: break;
+    }
+    return Widget::key_press_event(keyboard);
+}
+
+void Scroll_area::receive(Widget& descendant,
+                          const detail::Screen_descriptor& tiles)
+{
+    auto at = painted_.find(&descendant);
+    if (at == std::end(painted_)) {
+        Painted painted;
+        painted.on_destroyed = descendant.destroyed.connect(
+            [this](Widget& destroyed) { this->erase(destroyed); });
+        at = painted_.emplace(&descendant, std::move(painted)).first;
+    }
+    else {
+        this->erase_tiles(at->second.tiles, at->second.underneath);
+        at->second.tiles.clear();
+    }
+    // Kept now, the parent may be mid-destruction when the tiles are erased.
+    const auto* parent    = descendant.parent();
+    at->second.underneath = parent != nullptr && parent != this
+                                ? parent->generate_wallpaper()
+                                : this->generate_wallpaper();
+    auto& painted         = at->second.tiles;
+    this->paint_wallpaper(descendant, painted);
+    // Virtual coordinates start at this inner top left, where content() is.
+    const auto x_origin = this->inner_x();
+    const auto y_origin = this->inner_y();
+    painted.reserve(painted.size() + tiles.size());
+    for (const auto& point_tile : tiles) {
+        const auto& point = point_tile.first;
+        if (point.x < x_origin || point.y < y_origin)
+            continue;
+        const Point local{point.x - x_origin, point.y - y_origin};
+        if (local.x >= canvas_.width() || local.y >= canvas_.height())
+            continue;
+        auto tile = point_tile.second;
+        imprint(descendant.brush, tile.brush);
+        canvas_(local.x, local.y) = tile;
+        painted[local]            = tile;
+    }
+}
+
+Area Scroll_area::content_size() const
+{
+    const auto* c = this->content();
+    if (c == nullptr)
+        return Area{0, 0};
+    return Area{full_length(c->width_policy, this->width()),
+                full_length(c->height_policy, this->height())};
+}
+
+Point Scroll_area::max_offset() const
+{
+    const auto w = this->width();
+    const auto h = this->height();
+    return Point{canvas_.width() > w ? canvas_.width() - w : 0,
+                 canvas_.height() > h ? canvas_.height() - h : 0};
+}
+
+void Scroll_area::update_geometry()
+{
+    auto* c = this->content();
+    if (c == nullptr)
+        return;
+    const auto size = this->content_size();
+    canvas_.resize(size.width, size.height);
+    System::post_event<Move_event>(*c,
+                                   Point{this->inner_x(), this->inner_y()});
+    System::post_event<Resize_event>(*c, size);
+    const auto max = this->max_offset();
+    offset_.x      = std::min(offset_.x, max.x);
+    offset_.y      = std::min(offset_.y, max.y);
+    this->update();
+}
+
+void Scroll_area::erase(Widget& descendant)
+{
+    const auto at = painted_.find(&descendant);
+    if (at == std::end(painted_))
+        return;
+    this->erase_tiles(at->second.tiles, at->second.underneath);
+    at->second.on_destroyed.disconnect();
+    painted_.erase(at);
+}
+
+void Scroll_area::erase_tiles(const detail::Screen_descriptor& tiles,
+                              const Glyph& underneath)
+{
+    // Leave tiles alone if another descendant has painted over them since.
+    for (const auto& point_tile : tiles) {
+        const auto& local = point_tile.first;
+        if (local.x >= canvas_.width() || local.y >= canvas_.height())
+            continue;
+        auto& tile = canvas_(local.x, local.y);
+        if (tile == point_tile.second)
+            tile = underneath;
+    }
+}
+
+void Scroll_area::paint_wallpaper(const Widget& descendant,
+                                  detail::Screen_descriptor& painted)
+{
+    // As on the Screen, a Layout only paints the space its children leave.
+    const bool layout = !descendant.children.get().empty() &&
+                        detail::Offscreen_host::as_host(descendant) == nullptr;
+    const auto empty_space = layout ? detail::find_empty_space(descendant)
+                                    : detail::Screen_mask{};
+    const Point first = layout ? empty_space.offset()
+                               : Point{descendant.x(), descendant.y()};
+    const Area area = layout ? empty_space.area()
+                             : Area{descendant.outer_width(),
+                                    descendant.outer_height()};
+    const auto x_origin  = this->inner_x();
+    const auto y_origin  = this->inner_y();
+    const auto wallpaper = descendant.generate_wallpaper();
+    for (auto y = first.y; y < first.y + area.height; ++y) {
+        for (auto x = first.x; x < first.x + area.width; ++x) {
+            if (x < x_origin || y < y_origin ||
+                (layout && !empty_space.at(x, y))) {
+                continue;
+            }
+            const Point local{x - x_origin, y - y_origin};
+            if (local.x >= canvas_.width() || local.y >= canvas_.height())
+                continue;
+            canvas_(local.x, local.y) = wallpaper;
+            painted[local]            = wallpaper;
+        }
+    }
+}
+
+}  // namespace cppurses
@@ -50,9 +50,11 @@ void Text_display::insert(Glyph_string text, std::size_t index) {
             }
         }
     }
+    const auto line = this->relayout_line(index);
     contents_.insert(std::begin(contents_) + index, std::begin(text),
                      std::end(text));
-    this->update();
+    this->update_display(line);
+    Widget::update();
     contents_modified(contents_);
 }
 
@@ -65,7 +67,9 @@ void Text_display::append(Glyph_string text) {
         }
     }
     contents_.append(text);
-    this->update();
+    // Text before the last line keeps its layout.
+    this->update_display(this->last_line());
+    Widget::update();
     contents_modified(contents_);
 }
 
@@ -77,8 +81,10 @@ void Text_display::erase(std::size_t index, std::size_t length) {
     if (length == Glyph_string::npos) {
         end = std::end(contents_);
     }
+    const auto line = this->relayout_line(index);
     contents_.erase(std::begin(contents_) + index, end);
-    this->update();
+    this->update_display(line);
+    Widget::update();
     contents_modified(contents_);
 }
 
@@ -86,8 +92,10 @@ void Text_display::pop_back() {
     if (contents_.empty()) {
         return;
     }
+    const auto line = this->relayout_line(contents_.size() - 1);
     contents_.pop_back();
-    this->update();
+    this->update_display(line);
+    Widget::update();
     contents_modified(contents_);
 }
 
@@ -105,22 +113,30 @@ void Text_display::set_alignment(Alignment type) {
 }
 
 void Text_display::scroll_up(std::size_t n) {
+    const auto previous = top_line_;
     if (n > this->top_line()) {
         top_line_ = 0;
     } else {
         top_line_ -= n;
     }
-    this->update();
+    this->screen_state().optimize.scrolled -=
+        static_cast<int>(previous - top_line_);
+    // The layout is unchanged, only which lines are shown.
+    Widget::update();
     scrolled_up(n);
 }
 
 void Text_display::scroll_down(std::size_t n) {
+    const auto previous = top_line_;
     if (this->top_line() + n > this->last_line()) {
         top_line_ = this->last_line();
     } else {
         top_line_ += n;
     }
-    this->update();
+    // Lets Screen shift the lines on the terminal instead of repainting them.
+    this->screen_state().optimize.scrolled +=
+        static_cast<int>(top_line_ - previous);
+    Widget::update();
     scrolled_down(n);
 }
 
@@ -224,13 +240,19 @@ bool Text_display::paint_event() {
 // }
 
 void Text_display::update_display(std::size_t from_line) {
-    std::size_t begin = display_state_.at(from_line).start_index;
-    display_state_.clear();
+    if (from_line >= display_state_.size()) {
+        from_line = this->last_line();
+    }
+    const std::size_t begin = display_state_.at(from_line).start_index;
     if (this->width() == 0) {
+        display_state_.clear();
         display_state_.push_back(Line_info{0, 0});
         return;
     }
-    std::size_t start_index{0};
+    // Lines before from_line do not depend on the text after them.
+    display_state_.erase(std::begin(display_state_) + from_line,
+                         std::end(display_state_));
+    std::size_t start_index{begin};
     std::size_t length{0};
     std::size_t last_space{0};
     for (std::size_t i{begin}; i < contents_.size(); ++i) {
@@ -242,6 +264,7 @@ void Text_display::update_display(std::size_t from_line) {
             display_state_.push_back(Line_info{start_index, length - 1});
             start_index += length;
             length = 0;
+            last_space = 0;
         } else if (length == this->width()) {
             if (this->word_wrap_enabled() && last_space > 0) {
                 i -= length - last_space;
@@ -261,16 +284,19 @@ void Text_display::update_display(std::size_t from_line) {
 }
 
 std::size_t Text_display::line_at(std::size_t index) const {
-    std::size_t line{0};
-    // TODO Can you binary search this?
-    for (const auto& info : display_state_) {
-        if (info.start_index <= index) {
-            ++line;
-        } else {
-            return line - 1;
-        }
-    }
-    return this->last_line();
+    // Lines are in order of start_index, the first line starts at zero.
+    const auto after = std::upper_bound(
+        std::begin(display_state_), std::end(display_state_), index,
+        [](std::size_t i, const Line_info& info) {
+            return i < info.start_index;
+        });
+    return std::distance(std::begin(display_state_), after) - 1;
+}
+
+std::size_t Text_display::relayout_line(std::size_t index) const {
+    // A word wrapped line can take text from the start of the next line.
+    const auto line = this->line_at(index);
+    return line > 0 ? line - 1 : 0;
 }
 
 std::size_t Text_display::display_height() const {
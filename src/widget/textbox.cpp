@@ -3,9 +3,11 @@
 #include <cstddef>
 #include <utility>
 
+#include <cppurses/painter/brush.hpp>
 #include <cppurses/painter/glyph_string.hpp>
 #include <cppurses/system/events/key.hpp>
 #include <cppurses/system/events/mouse.hpp>
+#include <cppurses/system/undo_stack.hpp>
 #include <cppurses/widget/focus_policy.hpp>
 #include <cppurses/widget/widgets/detail/textbox_base.hpp>
 
@@ -14,6 +16,30 @@ namespace cppurses {
 Textbox::Textbox(Glyph_string contents) : Textbox_base{std::move(contents)} {
     this->set_name("Textbox");
     this->focus_policy = Focus_policy::Strong;
+    // Indices in the history are only valid for edits made through it.
+    this->contents_modified.connect([this](const Glyph_string&) {
+        if (!applying_edit_) {
+            history_.clear();
+        }
+    });
+}
+
+void Textbox::undo() {
+    if (!history_.can_undo()) {
+        return;
+    }
+    const Text_edit& e{history_.undo()};
+    this->restore(e.index, e.inserted.size(), e.removed);
+    this->set_cursor(e.index + e.removed.size());
+}
+
+void Textbox::redo() {
+    if (!history_.can_redo()) {
+        return;
+    }
+    const Text_edit& e{history_.redo()};
+    this->restore(e.index, e.removed.size(), e.inserted);
+    this->set_cursor(e.index + e.inserted.size());
 }
 
 void Textbox::set_wheel_speed(std::size_t lines) {
@@ -25,15 +51,19 @@ bool Textbox::key_press_event(const Key::State& keyboard) {
     switch (keyboard.key) {
         case Key::Arrow_right:
             this->cursor_right(1);
+            history_.break_merge();
             break;
         case Key::Arrow_left:
             this->cursor_left(1);
+            history_.break_merge();
             break;
         case Key::Arrow_up:
             this->cursor_up(1);
+            history_.break_merge();
             break;
         case Key::Arrow_down:
             this->cursor_down(1);
+            history_.break_merge();
             break;
         default:
             break;
@@ -42,13 +72,21 @@ bool Textbox::key_press_event(const Key::State& keyboard) {
         return true;
     }
     switch (keyboard.key) {
-        case Key::Backspace: 
+        case Key::Ctrl_z:
+            this->undo();
+            break;
+
+        case Key::Ctrl_y:
+            this->redo();
+            break;
+
+        case Key::Backspace:
         case Key::Backspace_2: {
             auto cursor_index = this->cursor_index();
             if (cursor_index == 0) {
                 break;
             }
-            this->erase(--cursor_index, 1);
+            this->edit(--cursor_index, 1, "");
             if (this->line_at(cursor_index) < this->top_line()) {
                 this->scroll_up(1);
             }
@@ -57,7 +95,7 @@ bool Textbox::key_press_event(const Key::State& keyboard) {
 
         case Key::Enter: {
             auto cursor_index = this->cursor_index();
-            this->insert('\n', cursor_index);
+            this->edit(cursor_index, 0, '\n');
             if (this->cursor.y() + 1 == this->height()) {
                 this->scroll_down(1);
             }
@@ -73,7 +111,7 @@ bool Textbox::key_press_event(const Key::State& keyboard) {
             if (text != '\0') {
                 // TODO Cursor Movement for Alignments other than left
                 auto cursor_index = this->cursor_index();
-                this->insert(text, cursor_index);
+                this->edit(cursor_index, 0, text);
                 this->cursor_right(1);
                 this->set_cursor(cursor_index + 1);
             }
@@ -83,6 +121,7 @@ bool Textbox::key_press_event(const Key::State& keyboard) {
 
 bool Textbox::mouse_press_event(const Mouse::State& mouse) {
     if (mouse.button == Mouse::Button::Left) {
+        history_.break_merge();
         this->set_cursor({mouse.local.x, mouse.local.y});
     } else if (mouse.button == Mouse::Button::ScrollUp) {
         if (scroll_wheel_) {
@@ -93,8 +132,68 @@ bool Textbox::mouse_press_event(const Mouse::State& mouse) {
             this->scroll_down(scroll_speed_down_);
         }
     }
-    this->update();
+    Widget::update();
     return Widget::mouse_press_event(mouse);
 }
 
+Glyph_string Textbox::replace(std::size_t index,
+                              std::size_t length,
+                              const Glyph_string& text) {
+    const auto first = std::begin(this->contents()) + index;
+    Glyph_string removed{first, first + length};
+    applying_edit_ = true;
+    if (length != 0) {
+        this->erase(index, length);
+    }
+    if (!text.empty()) {
+        this->insert(text, index);
+    }
+    applying_edit_ = false;
+    return removed;
+}
+
+void Textbox::restore(std::size_t index,
+                      std::size_t length,
+                      const Glyph_string& text) {
+    // The stored Glyphs already have the attributes they were typed with.
+    const Brush insert_brush{this->insert_brush};
+    this->insert_brush.clear_attributes();
+    this->replace(index, length, text);
+    this->insert_brush = insert_brush;
+}
+
+void Textbox::edit(std::size_t index,
+                   std::size_t length,
+                   const Glyph_string& text) {
+    Glyph_string removed{this->replace(index, length, text)};
+    // Inserted Glyphs may have picked up the insert_brush, store them as is.
+    const auto first = std::begin(this->contents()) + index;
+    Glyph_string inserted{first, first + text.size()};
+    history_.push({index, std::move(removed), std::move(inserted)});
+}
+
+std::size_t Textbox::Text_edit::bytes() const {
+    return sizeof(Text_edit) +
+           (removed.size() + inserted.size()) * sizeof(Glyph);
+}
+
+bool Textbox::Text_edit::merge(const Text_edit& next) {
+    // A line of typing is one edit, ending with the newline that closes it.
+    const bool typing = removed.empty() && next.removed.empty() &&
+                        next.index == index + inserted.size() &&
+                        !inserted.empty() && inserted.back().symbol != L'\n';
+    if (typing) {
+        inserted.append(next.inserted);
+        return true;
+    }
+    const bool erasing = inserted.empty() && next.inserted.empty() &&
+                         next.index + next.removed.size() == index;
+    if (erasing) {
+        removed = next.removed + removed;
+        index = next.index;
+        return true;
+    }
+    return false;
+}
+
 }  // namespace cppurses
@@ -0,0 +1,423 @@
+#include <cppurses/widget/widgets/virtual_menu.hpp>
+
+#include <algorithm>
+#include <cstddef>
+#include <cwctype>
+#include <future>
+#include <iterator>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <utility>
+#include <vector>
+
+#include <signals/signals.hpp>
+
+#include <cppurses/painter/attribute.hpp>
+#include <cppurses/painter/glyph_string.hpp>
+#include <cppurses/painter/painter.hpp>
+#include <cppurses/system/events/custom_event.hpp>
+#include <cppurses/system/events/key.hpp>
+#include <cppurses/system/events/mouse.hpp>
+#include <cppurses/system/system.hpp>
+#include <cppurses/widget/area.hpp>
+#include <cppurses/widget/focus_policy.hpp>
+
+namespace {
+
+/// Return the lower case search key for \p label.
+std::wstring make_key(const cppurses::Glyph_string& label)
+{
+    auto key = label.w_str();
+    std::transform(std::begin(key), std::end(key), std::begin(key),
+                   [](wchar_t c) { return std::towlower(c); });
+    return key;
+}
+
+/// Return \p pattern in lower case, to be compared against keys.
+std::wstring to_lower(std::wstring pattern)
+{
+    std::transform(std::begin(pattern), std::end(pattern), std::begin(pattern),
+                   [](wchar_t c) { return std::towlower(c); });
+    return pattern;
+}
+
+bool matches(const std::wstring& key, const std::wstring& lower_pattern)
+{
+    return key.find(lower_pattern) != std::wstring::npos;
+}
+
+/// Return true if every item that matches \p now also matched \p before.
+bool narrows(const std::wstring& now, const std::wstring& before)
+{
+    return now.size() >= before.size() &&
+           now.compare(0, before.size(), before) == 0;
+}
+
+}  // namespace
+
+namespace cppurses {
+
+Virtual_menu::Virtual_menu()
+{
+    this->set_name("Virtual_menu");
+    this->focus_policy = Focus_policy::Strong;
+}
+
+Virtual_menu::~Virtual_menu()
+{
+    ++generation_;
+    if (worker_.valid())
+        worker_.wait();
+}
+
+void Virtual_menu::append_item(Glyph_string label)
+{
+    this->writable_keys().push_back(make_key(label));
+    labels_.push_back(std::move(label));
+    // A running filter picks up appended items when its result is collected.
+    if (!filter_pending_ && matches_pattern_ == filter_ &&
+        matches(keys_->back(), to_lower(filter_))) {
+        matches_.push_back(labels_.size() - 1);
+    }
+    this->update();
+}
+
+void Virtual_menu::insert_item(Glyph_string label, std::size_t index)
+{
+    if (index > labels_.size())
+        return;
+    auto& keys = this->writable_keys();
+    keys.insert(std::begin(keys) + index, make_key(label));
+    labels_.insert(std::begin(labels_) + index, std::move(label));
+    for (auto& match : matches_) {
+        if (match >= index)
+            ++match;
+    }
+    if (filter_pending_) {
+        this->apply_filter();
+        return;
+    }
+    if (matches(keys[index], to_lower(matches_pattern_))) {
+        auto at = std::lower_bound(std::begin(matches_), std::end(matches_),
+                                   index);
+        matches_.insert(at, index);
+    }
+    this->update();
+}
+
+void Virtual_menu::remove_item(std::size_t index)
+{
+    if (index >= labels_.size())
+        return;
+    auto& keys = this->writable_keys();
+    keys.erase(std::begin(keys) + index);
+    labels_.erase(std::begin(labels_) + index);
+    matches_.erase(std::remove(std::begin(matches_), std::end(matches_), index),
+                   std::end(matches_));
+    for (auto& match : matches_) {
+        if (match > index)
+            --match;
+    }
+    if (filter_pending_) {
+        this->apply_filter();
+        return;
+    }
+    if (selected_ >= matches_.size() && selected_ != 0)
+        selected_ = matches_.size() - 1;
+    this->scroll_to_selected();
+    this->update();
+}
+
+void Virtual_menu::clear()
+{
+    ++generation_;
+    filter_pending_ = false;
+    labels_.clear();
+    keys_ = std::make_shared<Keys_t>();
+    matches_.clear();
+    matches_pattern_ = filter_;
+    selected_ = 0;
+    top_      = 0;
+    this->update();
+}
+
+void Virtual_menu::select_item(std::size_t index)
+{
+    auto at = std::lower_bound(std::begin(matches_), std::end(matches_), index);
+    if (at == std::end(matches_) || *at != index)
+        return;
+    selected_ = std::distance(std::begin(matches_), at);
+    this->scroll_to_selected();
+    this->update();
+}
+
+std::size_t Virtual_menu::selected_item() const
+{
+    if (selected_ >= matches_.size())
+        return labels_.size();
+    return matches_[selected_];
+}
+
+void Virtual_menu::select_up(std::size_t n)
+{
+    selected_ = selected_ > n ? selected_ - n : 0;
+    this->scroll_to_selected();
+    this->update();
+}
+
+void Virtual_menu::select_down(std::size_t n)
+{
+    if (matches_.empty())
+        return;
+    selected_ = std::min(selected_ + n, matches_.size() - 1);
+    this->scroll_to_selected();
+    this->update();
+}
+
+void Virtual_menu::set_selected_attribute(const Attribute& attr)
+{
+    selected_attr_ = attr;
+    this->update();
+}
+
+void Virtual_menu::set_filter(std::wstring pattern)
+{
+    if (pattern == filter_)
+        return;
+    filter_ = std::move(pattern);
+    this->apply_filter();
+    filter_changed(filter_);
+}
+
+bool Virtual_menu::paint_event()
+{
+    Painter p{*this};
+    const auto rows  = this->visible_rows();
+    const auto width = this->width();
+    const auto end   = std::min(top_ + rows, matches_.size());
+    for (auto i = top_; i < end; ++i) {
+        const auto y = i - top_;
+        if (i != selected_) {
+            p.put(labels_[matches_[i]], 0, y);
+            continue;
+        }
+        Glyph_string highlighted{labels_[matches_[i]]};
+        if (highlighted.size() < width)
+            highlighted.append(std::wstring(width - highlighted.size(), L' '));
+        highlighted.add_attributes(selected_attr_);
+        p.put(highlighted, 0, y);
+    }
+    if (rows < this->height()) {
+        Glyph_string prompt{L'/'};
+        prompt.append(filter_);
+        if (filter_pending_)
+            prompt.append(L" ...");
+        p.put(prompt, 0, rows);
+    }
+    return Widget::paint_event();
+}
+
+bool Virtual_menu::key_press_event(const Key::State& keyboard)
+{
+    switch (keyboard.key) {
+        case Key::Arrow_up: this->select_up(); break;
+        case Key::Arrow_down: this->select_down(); break;
+        case Key::Previous_page: this->select_up(this->visible_rows()); break;
+        case Key::Next_page: this->select_down(this->visible_rows()); break;
+        case Key::Enter: this->send_selected_signal(); break;
+        case Key::Escape: this->set_filter(L""); break;
+        case Key::Backspace:
+        case Key::Backspace_:
+        case Key::Backspace_2:
+            if (!filter_.empty())
+                this->set_filter(filter_.substr(0, filter_.size() - 1));
+            break;
+        default:
+            if (keyboard.symbol != '\0' && std::iswprint(keyboard.symbol))
+                this->set_filter(filter_ + wchar_t(keyboard.symbol));
+            break;
+    }
+    return Widget::key_press_event(keyboard);
+}
+
+bool Virtual_menu::mouse_press_event(const Mouse::State& mouse)
+{
+    if (mouse.button == Mouse::Button::ScrollUp)
+        this->select_up();
+    else if (mouse.button == Mouse::Button::ScrollDown)
+        this->select_down();
+    else if (mouse.button == Mouse::Button::Left &&
+             mouse.local.y < this->visible_rows() &&
+             top_ + mouse.local.y < matches_.size()) {
+        selected_ = top_ + mouse.local.y;
+        this->update();
+        this->send_selected_signal();
+    }
+    return Widget::mouse_press_event(mouse);
+}
+
+bool Virtual_menu::resize_event(Area new_size, Area old_size)
+{
+    const auto result = Widget::resize_event(new_size, old_size);
+    this->scroll_to_selected();
+    return result;
+}
+
+bool Virtual_menu::enable_event()
+{
+    // The result Event is dropped if it arrives while this is disabled.
+    this->collect_filter_result();
+    return Widget::enable_event();
+}
+
+std::size_t Virtual_menu::visible_rows() const
+{
+    const auto height = this->height();
+    return filter_.empty() || height < 2 ? height : height - 1;
+}
+
+void Virtual_menu::scroll_to_selected()
+{
+    const auto rows = this->visible_rows();
+    if (selected_ < top_)
+        top_ = selected_;
+    else if (rows != 0 && selected_ >= top_ + rows)
+        top_ = selected_ - rows + 1;
+}
+
+auto Virtual_menu::writable_keys() -> Keys_t&
+{
+    if (keys_.use_count() > 1)
+        keys_ = std::make_shared<Keys_t>(*keys_);
+    return *keys_;
+}
+
+void Virtual_menu::apply_filter()
+{
+    const auto generation = ++generation_;
+    const auto pattern    = to_lower(filter_);
+    const bool narrowing =
+        !filter_pending_ && narrows(filter_, matches_pattern_);
+
+    std::vector<std::size_t> candidates;
+    if (narrowing) {
+        candidates = matches_;
+    }
+    else {
+        candidates.resize(keys_->size());
+        for (std::size_t i{0}; i < candidates.size(); ++i)
+            candidates[i] = i;
+    }
+
+    if (candidates.size() < async_threshold_) {
+        filter_pending_ = false;
+        const auto& keys = *keys_;
+        candidates.erase(
+            std::remove_if(std::begin(candidates), std::end(candidates),
+                           [&](std::size_t i) {
+                               return !matches(keys[i], pattern);
+                           }),
+            std::end(candidates));
+        this->set_matches(std::move(candidates), filter_);
+        return;
+    }
+
+    filter_pending_ = true;
+    this->update();
+    std::shared_ptr<const Keys_t> keys = keys_;
+    // Replacing worker_ waits on the previous filter, which is already
+    // cancelled by the generation increment above.
+    worker_ = std::async(std::launch::async, [this, keys, pattern, generation,
+                                              candidates = std::move(candidates),
+                                              filter     = filter_] {
+        std::vector<std::size_t> found;
+        std::size_t count{0};
+        for (std::size_t i : candidates) {
+            if (++count % 4096 == 0 && generation_ != generation)
+                return;
+            if (matches((*keys)[i], pattern))
+                found.push_back(i);
+        }
+        {
+            std::lock_guard<std::mutex> lock{result_mtx_};
+            if (generation_ != generation)
+                return;
+            result_ = Filter_result{generation, filter, keys->size(),
+                                    std::move(found), true};
+        }
+        System::post_event<Custom_event>(
+            *this, [this] { this->collect_filter_result(); });
+    });
+}
+
+void Virtual_menu::collect_filter_result()
+{
+    Filter_result result;
+    {
+        std::lock_guard<std::mutex> lock{result_mtx_};
+        if (!result_.ready || result_.generation != generation_)
+            return;
+        result = std::move(result_);
+        result_.ready = false;
+    }
+    // Items appended while the worker ran were not in its key snapshot.
+    const auto pattern = to_lower(result.pattern);
+    for (auto i = result.key_count; i < keys_->size(); ++i) {
+        if (matches((*keys_)[i], pattern))
+            result.matches.push_back(i);
+    }
+    filter_pending_ = false;
+    this->set_matches(std::move(result.matches), std::move(result.pattern));
+}
+
+void Virtual_menu::set_matches(std::vector<std::size_t> matches,
+                               std::wstring pattern)
+{
+    matches_         = std::move(matches);
+    matches_pattern_ = std::move(pattern);
+    selected_        = 0;
+    top_             = 0;
+    this->update();
+}
+
+void Virtual_menu::send_selected_signal()
+{
+    if (selected_ < matches_.size())
+        selected(matches_[selected_]);
+}
+
+namespace slot {
+
+sig::Slot<void()> select_up(Virtual_menu& m, std::size_t n)
+{
+    sig::Slot<void()> slot{[&m, n] { m.select_up(n); }};
+    slot.track(m.destroyed);
+    return slot;
+}
+
+sig::Slot<void()> select_down(Virtual_menu& m, std::size_t n)
+{
+    sig::Slot<void()> slot{[&m, n] { m.select_down(n); }};
+    slot.track(m.destroyed);
+    return slot;
+}
+
+sig::Slot<void(std::size_t)> select_item(Virtual_menu& m)
+{
+    sig::Slot<void(std::size_t)> slot{
+        [&m](auto index) { m.select_item(index); }};
+    slot.track(m.destroyed);
+    return slot;
+}
+
+sig::Slot<void(std::wstring)> set_filter(Virtual_menu& m)
+{
+    sig::Slot<void(std::wstring)> slot{
+        [&m](std::wstring pattern) { m.set_filter(std::move(pattern)); }};
+    slot.track(m.destroyed);
+    return slot;
+}
+
+}  // namespace slot
+}  // namespace cppurses
@@ -39,7 +39,6 @@ bool Widget::child_polished_event(Widget& /* child */)
 bool Widget::move_event(Point new_position, Point /* old_position */)
 {
     moved(new_position);
-    this->update();
     return true;
 }
 
@@ -0,0 +1,59 @@
+#include <gtest/gtest.h>
+
+#include <cppurses/painter/attribute.hpp>
+#include <cppurses/painter/brush.hpp>
+#include <cppurses/painter/color.hpp>
+
+using cppurses::Attribute;
+using cppurses::background;
+using cppurses::Brush;
+using cppurses::Color;
+using cppurses::foreground;
+
+TEST(BrushStyleTest, ColorsAndAttributes) {
+    Brush b{Attribute::Bold, background(Color::Light_gray),
+            foreground(Color::Black)};
+    EXPECT_TRUE(b.has_attribute(Attribute::Bold));
+    EXPECT_FALSE(b.has_attribute(Attribute::Blink));
+    ASSERT_TRUE(bool(b.background_color()));
+    EXPECT_EQ(Color::Light_gray, *b.background_color());
+    ASSERT_TRUE(bool(b.foreground_color()));
+    EXPECT_EQ(Color::Black, *b.foreground_color());
+
+    b.set_background(Color::Red);
+    EXPECT_EQ(Color::Red, *b.background_color());
+    b.remove_foreground();
+    EXPECT_FALSE(bool(b.foreground_color()));
+    b.clear_attributes();
+    EXPECT_FALSE(b.has_attribute(Attribute::Bold));
+    EXPECT_TRUE(Brush{background(Color::Red)} == b);
+}
+
+TEST(BrushStyleTest, EqualBrushesHaveEqualStyles) {
+    const Brush a{Attribute::Italic, foreground(Color::Orange)};
+    Brush b{foreground(Color::Orange)};
+    EXPECT_FALSE(a == b);
+    EXPECT_NE(a.style(), b.style());
+    b.add_attributes(Attribute::Italic);
+    EXPECT_TRUE(a == b);
+    EXPECT_EQ(a.style(), b.style());
+    b.remove_attributes(Attribute::Italic);
+    b.add_attributes(Attribute::Italic);
+    EXPECT_EQ(a.style(), b.style());
+}
+
+TEST(BrushStyleTest, ImprintKeepsExistingColors) {
+    const Brush from{Attribute::Underline, background(Color::Blue),
+                     foreground(Color::White)};
+    Brush to{Attribute::Bold, foreground(Color::Green)};
+    imprint(from, to);
+    EXPECT_TRUE(to.has_attribute(Attribute::Bold));
+    EXPECT_TRUE(to.has_attribute(Attribute::Underline));
+    ASSERT_TRUE(bool(to.background_color()));
+    EXPECT_EQ(Color::Blue, *to.background_color());
+    EXPECT_EQ(Color::Green, *to.foreground_color());
+
+    Brush empty;
+    imprint(Brush{}, empty);
+    EXPECT_TRUE(empty == Brush{});
+}
@@ -0,0 +1,79 @@
+#include <sstream>
+#include <stdexcept>
+#include <string>
+
+#include <gtest/gtest.h>
+
+#include <cppurses/painter/attribute.hpp>
+#include <cppurses/painter/color.hpp>
+#include <cppurses/painter/glyph.hpp>
+#include <cppurses/painter/glyph_file.hpp>
+#include <cppurses/painter/glyph_matrix.hpp>
+
+using cppurses::Attribute;
+using cppurses::background;
+using cppurses::Color;
+using cppurses::foreground;
+using cppurses::Glyph;
+using cppurses::Glyph_file;
+using cppurses::Glyph_file_writer;
+using cppurses::Glyph_matrix;
+
+TEST(GlyphFileTest, MatrixRoundTrip) {
+    Glyph_matrix gm{4, 3};
+    gm(1, 0) = Glyph{L'Ѯ', background(Color::Orange), Attribute::Bold};
+    gm(2, 0) = Glyph{L'Ѯ', background(Color::Orange), Attribute::Bold};
+    gm(3, 2) = Glyph{L'x', foreground(Color::Light_blue), Attribute::Inverse};
+    std::ostringstream os;
+    write_glyph_file(os, gm);
+
+    const std::string data{os.str()};
+    ASSERT_TRUE(Glyph_file::has_signature(data.data(), data.size()));
+    const Glyph_matrix read{Glyph_file{data.data(), data.size()}.to_matrix()};
+    ASSERT_EQ(4, read.width());
+    ASSERT_EQ(3, read.height());
+    for (std::size_t y{0}; y < gm.height(); ++y) {
+        for (std::size_t x{0}; x < gm.width(); ++x) {
+            EXPECT_EQ(gm(x, y), read(x, y));
+        }
+    }
+}
+
+TEST(GlyphFileTest, EmptyCellsAreSkipped) {
+    Glyph_file_writer writer{10, 2};
+    writer.skip(12);
+    writer.append(Glyph{L'a'}, 3);
+    std::ostringstream os;
+    writer.write(os);
+
+    const std::string data{os.str()};
+    const Glyph_file file{data.data(), data.size()};
+    int runs{0};
+    file.for_each_run([&runs](std::size_t x, std::size_t y, std::size_t length,
+                              const Glyph& glyph) {
+        EXPECT_EQ(2, x);
+        EXPECT_EQ(1, y);
+        EXPECT_EQ(3, length);
+        EXPECT_EQ(L'a', glyph.symbol);
+        ++runs;
+    });
+    EXPECT_EQ(1, runs);
+}
+
+TEST(GlyphFileTest, RejectsTruncatedData) {
+    std::ostringstream os;
+    write_glyph_file(os, Glyph_matrix{5, 5});
+    const std::string data{os.str()};
+    EXPECT_THROW((Glyph_file{data.data(), data.size() - 1}),
+                 std::runtime_error);
+    EXPECT_THROW((Glyph_file{data.data(), 3}), std::runtime_error);
+}
+
+TEST(GlyphFileTest, RejectsAreaTooLarge) {
+    std::ostringstream os;
+    Glyph_file_writer writer{0xFFFFFFFF, 1};
+    writer.append(Glyph{L'x'});
+    writer.write(os);
+    const std::string data{os.str()};
+    EXPECT_THROW((Glyph_file{data.data(), data.size()}), std::runtime_error);
+}
@@ -1,11 +1,11 @@
-#include <painter/attribute.hpp>
-#include <painter/color.hpp>
-#include <painter/glyph.hpp>
-#include <painter/glyph_matrix.hpp>
+#include <stdexcept>
 
 #include <gtest/gtest.h>
 
-#include <stdexcept>
+#include <cppurses/painter/attribute.hpp>
+#include <cppurses/painter/color.hpp>
+#include <cppurses/painter/glyph.hpp>
+#include <cppurses/painter/glyph_matrix.hpp>
 
 using cppurses::Attribute;
 using cppurses::background;
@@ -46,10 +46,40 @@ TEST(GlyphMatrixTest, Default) {
     ASSERT_EQ(5, cgm.height());
 
     Glyph_matrix gm2(5, 3);
-    gm2.at(4, 2) = Glyph{"Ѯ", background(Color::Orange), Attribute::Bold};
-    EXPECT_EQ("Ѯ", gm2.at(4, 2).str());
-    EXPECT_EQ(" ", gm2.at(0, 0).str());
+    gm2.at(4, 2) = Glyph{L'Ѯ', background(Color::Orange), Attribute::Bold};
+    EXPECT_EQ(L'Ѯ', gm2.at(4, 2).symbol);
+    EXPECT_EQ(L' ', gm2.at(0, 0).symbol);
     EXPECT_THROW(gm2.at(5, 3), std::out_of_range);
     EXPECT_THROW(gm2.at(4, 3), std::out_of_range);
     EXPECT_THROW(gm2.at(5, 2), std::out_of_range);
 }
+
+TEST(GlyphMatrixTest, ResizeKeepsPositions) {
+    Glyph_matrix gm{3, 2};
+    gm(2, 1) = Glyph{L'x'};
+    gm(0, 1) = Glyph{L'y'};
+
+    gm.resize(5, 4);
+    ASSERT_EQ(5, gm.width());
+    ASSERT_EQ(4, gm.height());
+    EXPECT_EQ(L'x', gm.at(2, 1).symbol);
+    EXPECT_EQ(L'y', gm.at(0, 1).symbol);
+    EXPECT_EQ(L' ', gm.at(4, 3).symbol);
+
+    gm.resize(1, 2);
+    EXPECT_EQ(L'y', gm.at(0, 1).symbol);
+    EXPECT_THROW(gm.at(2, 1), std::out_of_range);
+
+    gm.clear();
+    EXPECT_EQ(0, gm.width());
+    EXPECT_EQ(0, gm.height());
+}
+
+TEST(GlyphMatrixTest, RowSpan) {
+    Glyph_matrix gm{4, 3};
+    ASSERT_EQ(4, gm.stride());
+    gm(3, 1) = Glyph{L'z'};
+    const Glyph* row = gm.row(1);
+    EXPECT_EQ(L'z', row[3].symbol);
+    EXPECT_EQ(&gm(0, 2), gm.row(1) + gm.stride());
+}
@@ -0,0 +1,79 @@
+#include <cstdio>
+#include <string>
+
+#include <ncurses.h>
+
+#include <gtest/gtest.h>
+
+#include <cppurses/system/detail/event_engine.hpp>
+#include <cppurses/system/system.hpp>
+#include <cppurses/widget/area.hpp>
+#include <cppurses/widget/point.hpp>
+#include <cppurses/widget/widgets/label.hpp>
+
+using cppurses::Area;
+using cppurses::Label;
+using cppurses::Point;
+using cppurses::System;
+using cppurses::detail::Event_engine;
+
+namespace {
+
+/// Return the \p length symbols on the ncurses screen from (x, y).
+std::string read_screen(int x, int y, int length) {
+    std::string text;
+    for (int i{0}; i < length; ++i) {
+        cchar_t cell;
+        mvin_wch(y, x + i, &cell);
+        wchar_t symbol[CCHARW_MAX + 1];
+        attr_t attributes;
+        short pair;
+        ::getcchar(&cell, symbol, &attributes, &pair, nullptr);
+        text.push_back(static_cast<char>(symbol[0]));
+    }
+    return text;
+}
+
+/// Send every queued Event and flush the changes to the ncurses screen.
+void flush() {
+    auto& engine = Event_engine::get();
+    engine.set_frame_rate(0);
+    engine.process();
+}
+
+}  // namespace
+
+TEST(LayersTest, MovedOverlayIsDrawnAtItsNewPosition) {
+    std::FILE* out = std::fopen("/dev/null", "w");
+    std::FILE* in = std::fopen("/dev/null", "r");
+    SCREEN* screen = ::newterm("xterm", out, in);
+    ASSERT_NE(nullptr, screen);
+    {
+        Label overlay{"POP"};
+        System::open_overlay(overlay, Point{1, 1}, Area{3, 1});
+        flush();
+        EXPECT_EQ("POP", read_screen(1, 1, 3));
+
+        System::move_overlay(overlay, Point{10, 4});
+        flush();
+        EXPECT_EQ("POP", read_screen(10, 4, 3));
+
+        System::close_overlay(overlay);
+        flush();
+    }
+    ::endwin();
+    ::delscreen(screen);
+    std::fclose(in);
+    std::fclose(out);
+}
+
+TEST(LayersTest, ClosedOverlayIsNotWatchedForDestruction) {
+    Label overlay{"POP"};
+    const auto slots = overlay.destroyed.num_slots();
+    for (int i{0}; i < 3; ++i) {
+        System::open_overlay(overlay, Point{1, 1}, Area{3, 1});
+        System::close_overlay(overlay);
+    }
+    EXPECT_EQ(slots, overlay.destroyed.num_slots());
+    Event_engine::get().queue().remove_events_of(&overlay);
+}
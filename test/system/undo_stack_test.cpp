@@ -0,0 +1,71 @@
+#include <cstddef>
+#include <string>
+
+#include <gtest/gtest.h>
+
+#include <cppurses/system/undo_stack.hpp>
+
+using cppurses::Undo_stack;
+
+namespace {
+
+/// Appends text, merges with the previous append if it has no space.
+struct Append {
+    std::string text;
+
+    std::size_t bytes() const { return text.size(); }
+
+    bool merge(const Append& next) {
+        if (next.text.find(' ') != std::string::npos) {
+            return false;
+        }
+        text += next.text;
+        return true;
+    }
+};
+
+}  // namespace
+
+TEST(UndoStackTest, UndoRedo) {
+    Undo_stack<Append> history;
+    EXPECT_FALSE(history.can_undo());
+    history.push({"a"});
+    history.push({" b"});
+    ASSERT_TRUE(history.can_undo());
+    EXPECT_EQ(" b", history.undo().text);
+    EXPECT_EQ("a", history.undo().text);
+    EXPECT_FALSE(history.can_undo());
+    ASSERT_TRUE(history.can_redo());
+    EXPECT_EQ("a", history.redo().text);
+    history.push({" c"});
+    EXPECT_FALSE(history.can_redo());
+    EXPECT_EQ(3, history.bytes());
+}
+
+TEST(UndoStackTest, Merge) {
+    Undo_stack<Append> history;
+    history.push({"a"});
+    history.push({"b"});
+    history.break_merge();
+    history.push({"c"});
+    history.push({"d"});
+    EXPECT_EQ("cd", history.undo().text);
+    EXPECT_EQ("ab", history.undo().text);
+    EXPECT_FALSE(history.can_undo());
+}
+
+TEST(UndoStackTest, ByteBudget) {
+    Undo_stack<Append> history{4};
+    history.push({"aa"});
+    history.push({" b"});
+    history.push({" c"});
+    EXPECT_EQ(4, history.bytes());
+    EXPECT_EQ(" c", history.undo().text);
+    EXPECT_EQ(" b", history.undo().text);
+    EXPECT_FALSE(history.can_undo());
+
+    history.set_byte_budget(2);
+    EXPECT_EQ(2, history.bytes());
+    EXPECT_EQ(" b", history.redo().text);
+    EXPECT_FALSE(history.can_redo());
+}
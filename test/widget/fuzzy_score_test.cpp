@@ -0,0 +1,38 @@
+#include <string>
+
+#include <gtest/gtest.h>
+
+#include <cppurses/widget/widgets/detail/fuzzy_score.hpp>
+
+using cppurses::detail::fuzzy_score;
+
+TEST(FuzzyScore, EmptyPatternMatchesEverything)
+{
+    EXPECT_EQ(1, fuzzy_score("", ""));
+    EXPECT_EQ(1, fuzzy_score("", "anything"));
+}
+
+TEST(FuzzyScore, RequiresOrderedSubsequence)
+{
+    EXPECT_GT(fuzzy_score("fb", "foo_bar"), 0);
+    EXPECT_EQ(0, fuzzy_score("bf", "foo_bar"));
+    EXPECT_EQ(0, fuzzy_score("fooo", "foo"));
+}
+
+TEST(FuzzyScore, CaseInsensitive)
+{
+    EXPECT_GT(fuzzy_score("readme", "README.md"), 0);
+}
+
+TEST(FuzzyScore, RanksConsecutiveAndWordStarts)
+{
+    EXPECT_GT(fuzzy_score("bar", "foo_bar"), fuzzy_score("bar", "b_a_r"));
+    EXPECT_GT(fuzzy_score("fb", "foo_bar"), fuzzy_score("fb", "fooxbar"));
+    EXPECT_GT(fuzzy_score("fb", "fooBar"), fuzzy_score("fb", "foobar"));
+}
+
+TEST(FuzzyScore, PrefersShorterCandidates)
+{
+    EXPECT_GT(fuzzy_score("main", "main.cpp"),
+              fuzzy_score("main", "main" + std::string(64, 'x')));
+}
@@ -0,0 +1,68 @@
+#include <cstdio>
+
+#include <ncurses.h>
+
+#include <gtest/gtest.h>
+
+#include <cppurses/painter/color.hpp>
+#include <cppurses/system/detail/event_engine.hpp>
+#include <cppurses/system/system.hpp>
+#include <cppurses/widget/area.hpp>
+#include <cppurses/widget/point.hpp>
+#include <cppurses/widget/widgets/scroll_area.hpp>
+#include <cppurses/widget/widgets/textbox.hpp>
+
+using cppurses::Area;
+using cppurses::Color;
+using cppurses::Point;
+using cppurses::Scroll_area;
+using cppurses::System;
+using cppurses::Textbox;
+using cppurses::detail::Event_engine;
+
+namespace {
+
+/// Return the color pair of the cell at (x, y) on the ncurses screen.
+short read_pair(int x, int y) {
+    cchar_t cell;
+    mvin_wch(y, x, &cell);
+    wchar_t symbol[CCHARW_MAX + 1];
+    attr_t attributes;
+    short pair;
+    ::getcchar(&cell, symbol, &attributes, &pair, nullptr);
+    return pair;
+}
+
+/// Send every queued Event and flush the changes to the ncurses screen.
+void flush() {
+    auto& engine = Event_engine::get();
+    engine.set_frame_rate(0);
+    engine.process();
+}
+
+}  // namespace
+
+TEST(ScrollAreaTest, ContentBackgroundFillsCellsWithoutText) {
+    std::FILE* out = std::fopen("/dev/null", "w");
+    std::FILE* in = std::fopen("/dev/null", "r");
+    SCREEN* screen = ::newterm("xterm", out, in);
+    ASSERT_NE(nullptr, screen);
+    {
+        Scroll_area area;
+        auto& text = area.make_child<Textbox>("hi");
+        text.brush.set_background(Color::Blue);
+        text.brush.set_foreground(Color::White);
+        System::open_overlay(area, Point{0, 0}, Area{10, 3});
+        flush();
+        const short text_pair{read_pair(0, 0)};
+        EXPECT_EQ(text_pair, read_pair(5, 0));
+        EXPECT_EQ(text_pair, read_pair(9, 2));
+
+        System::close_overlay(area);
+        flush();
+    }
+    ::endwin();
+    ::delscreen(screen);
+    std::fclose(in);
+    std::fclose(out);
+}
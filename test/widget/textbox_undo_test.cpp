@@ -0,0 +1,67 @@
+#include <gtest/gtest.h>
+
+#include <cppurses/painter/attribute.hpp>
+#include <cppurses/system/events/key.hpp>
+#include <cppurses/system/detail/event_engine.hpp>
+#include <cppurses/system/events/resize_event.hpp>
+#include <cppurses/system/system.hpp>
+#include <cppurses/widget/area.hpp>
+#include <cppurses/widget/widgets/textbox.hpp>
+
+using cppurses::Area;
+using cppurses::Attribute;
+using cppurses::Key;
+using cppurses::Resize_event;
+using cppurses::System;
+using cppurses::Textbox;
+using cppurses::detail::Event_engine;
+
+namespace {
+
+void press(Textbox& tb, Key::Code key) {
+    System::send_event(Key::Press{tb, key});
+}
+
+class TextboxUndoTest : public ::testing::Test {
+   protected:
+    void SetUp() override {
+        tb.enable();
+        System::send_event(Resize_event{tb, Area{20, 4}});
+    }
+
+    // Events posted to tb would otherwise outlive it, in the shared queue.
+    void TearDown() override {
+        Event_engine::get().queue().remove_events_of(&tb);
+    }
+
+    Textbox tb;
+};
+
+}  // namespace
+
+TEST_F(TextboxUndoTest, UndoRestoresErasedGlyphsAsTheyWere) {
+    tb.set_contents("ab");
+    tb.set_cursor(2);
+    tb.insert_brush.add_attributes(Attribute::Bold);
+
+    press(tb, Key::Backspace);
+    ASSERT_EQ(1, tb.contents().size());
+    tb.undo();
+    ASSERT_EQ(2, tb.contents().size());
+    EXPECT_EQ(L'b', tb.contents()[1].symbol);
+    EXPECT_FALSE(tb.contents()[1].brush.has_attribute(Attribute::Bold));
+}
+
+TEST_F(TextboxUndoTest, RedoKeepsTheAttributesTypedWith) {
+    tb.insert_brush.add_attributes(Attribute::Bold);
+    press(tb, Key::c);
+    tb.insert_brush.clear_attributes();
+    tb.insert_brush.add_attributes(Attribute::Italic);
+
+    tb.undo();
+    EXPECT_TRUE(tb.contents().empty());
+    tb.redo();
+    ASSERT_EQ(1, tb.contents().size());
+    EXPECT_TRUE(tb.contents()[0].brush.has_attribute(Attribute::Bold));
+    EXPECT_FALSE(tb.contents()[0].brush.has_attribute(Attribute::Italic));
+}